@@ -0,0 +1,101 @@
+// Cost of per-module CPU accounting on a call into a module.
+//
+//   call_overhead_bench [iterations]
+//
+// Times a trivial virtual call (isHealthy) into calculator_v1 bare and inside
+// a ModuleCallScope for each CpuClock (and sampled TSC), and checks the added
+// cost per call against the overhead budget below. Exits non-zero if a budget
+// is blown. Build with CMAKE_BUILD_TYPE=Release for meaningful numbers.
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include "../src/core/ModuleManager.hpp"
+#include "../src/core/HealthMonitor.hpp"
+#include "../src/core/ModuleCallScope.hpp"
+
+namespace {
+
+// Added cost per call we are willing to pay
+constexpr double kScopeOnlyBudgetNs = 20;     // CpuClock::OFF
+constexpr double kSampledBudgetNs = 20;       // CpuClock::TSC, 1 in kSamplingPeriod calls timed
+constexpr double kTscBudgetNs = 150;          // CpuClock::TSC (rdtsc is slower under virtualization)
+constexpr double kThreadCpuBudgetNs = 1500;   // CpuClock::THREAD_CPUTIME (clock_gettime syscall x2)
+constexpr uint32_t kSamplingPeriod = 64;
+
+volatile bool sink;
+
+template <typename Call>
+double nsPerCall(long iterations, Call call) {
+    for (long i = 0; i < iterations / 10; i++) {
+        call(); // warm up
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; i++) {
+        call();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / iterations;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    long iterations = argc > 1 ? std::atol(argv[1]) : 2000000;
+
+    auto& manager = ModuleManager::getInstance();
+    if (!manager.loadModule("./calculator_v1.so")) {
+        std::cerr << "Failed to load ./calculator_v1.so (run from the build directory)" << std::endl;
+        return 1;
+    }
+    IModule* module = manager.getModule("Calculator");
+    uint32_t moduleId = HealthMonitor::getInstance().getModuleId("Calculator");
+
+    auto scoped = [module, moduleId]() {
+        ModuleCallScope scope(moduleId);
+        sink = module->isHealthy();
+    };
+
+    double bare = nsPerCall(iterations, [module]() { sink = module->isHealthy(); });
+
+    struct Mode {
+        const char* name;
+        ModuleCallScope::CpuClock clock;
+        uint32_t samplingPeriod;
+        double budgetNs;
+        long iterations;
+    };
+    const Mode modes[] = {
+        {"scope only (OFF)", ModuleCallScope::CpuClock::OFF, 1, kScopeOnlyBudgetNs, iterations},
+        {"TSC sampled 1/64", ModuleCallScope::CpuClock::TSC, kSamplingPeriod, kSampledBudgetNs, iterations},
+        {"TSC", ModuleCallScope::CpuClock::TSC, 1, kTscBudgetNs, iterations},
+        {"THREAD_CPUTIME", ModuleCallScope::CpuClock::THREAD_CPUTIME, 1, kThreadCpuBudgetNs, iterations / 10},
+    };
+
+    std::cout << "\n=== Module call overhead (" << iterations << " calls) ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(20) << "bare call" << std::right << std::setw(10) << bare << " ns" << std::endl;
+
+    bool withinBudget = true;
+    for (const Mode& mode : modes) {
+        ModuleCallScope::setCpuClock(mode.clock);
+        ModuleCallScope::setSamplingPeriod(mode.samplingPeriod);
+        if (ModuleCallScope::cpuClock() != mode.clock) {
+            std::cout << std::left << std::setw(20) << mode.name << "  (not available here)" << std::endl;
+            continue;
+        }
+        double overhead = nsPerCall(mode.iterations, scoped) - bare;
+        bool ok = overhead <= mode.budgetNs;
+        withinBudget = withinBudget && ok;
+        std::cout << std::left << std::setw(20) << mode.name << std::right << std::setw(10) << overhead
+                  << " ns added  (budget " << mode.budgetNs << " ns) " << (ok ? "OK" : "OVER BUDGET") << std::endl;
+    }
+
+    std::cout << "Accounted: " << ModuleCallScope::callCount(moduleId) << " calls, "
+              << ModuleCallScope::cpuTimeNs(moduleId) / 1000000 << " ms CPU" << std::endl;
+
+    ModuleCallScope::setCpuClock(ModuleCallScope::CpuClock::THREAD_CPUTIME);
+    ModuleCallScope::setSamplingPeriod(1);
+    manager.unloadModule("Calculator");
+    return withinBudget ? 0 : 1;
+}
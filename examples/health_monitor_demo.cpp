@@ -155,7 +155,7 @@ void demonstrateHealthMonitoring() {
     
     std::cout << "Calculator metrics:" << std::endl;
     std::cout << "  - Total loads: " << calculatorMetrics.totalLoads << std::endl;
-    std::cout << "  - Average load time: " << calculatorMetrics.averageLoadTime.count() << "ms" << std::endl;
+    std::cout << "  - Average load time: " << std::chrono::duration<double, std::milli>(calculatorMetrics.averageLoadTime).count() << "ms" << std::endl;
     
     std::cout << "UnstableModule metrics:" << std::endl;
     std::cout << "  - Total loads: " << unstableMetrics.totalLoads << std::endl;
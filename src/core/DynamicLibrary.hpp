@@ -13,6 +13,7 @@ public:
     void* getFunction(const std::string& functionName);
     bool isLoaded() const;
     std::string getPath() const { return path; }
+    void* getHandle() const { return handle; }
 
     // Copying prevent karne ke liye
     DynamicLibrary(const DynamicLibrary&) = delete;
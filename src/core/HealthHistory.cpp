@@ -0,0 +1,224 @@
+#include "HealthHistory.hpp"
+#include "../utils/Logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint32_t kHistoryMagic = 0x31484853; // "SHH1"
+constexpr uint32_t kHistoryVersion = 1;
+constexpr int64_t kMinuteNs = 60ll * 1000000000ll;
+constexpr int64_t kHourNs = 60 * kMinuteNs;
+constexpr uint8_t kUnhealthyStatus = 2; // HealthMonitor::HealthStatus::UNHEALTHY
+
+static_assert(sizeof(HealthSample) == 16, "HealthSample is part of the history file layout");
+static_assert(std::is_trivially_copyable<HealthSample>::value &&
+              std::is_trivially_copyable<HealthRollup>::value, "History records are memcpy'd");
+
+} // namespace
+
+HealthHistory::HealthHistory() : layout(nullptr), usedRecords(0) {
+    // Reserved, not committed: untouched module records cost no memory
+    void* mapping = mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mapping == MAP_FAILED) {
+        Logger::getInstance().error("Failed to reserve health history: " + std::string(strerror(errno)),
+                                    "HealthHistory");
+        return;
+    }
+    layout = static_cast<Layout*>(mapping);
+    initializeHeader(layout->header);
+}
+
+HealthHistory::~HealthHistory() {
+    if (layout) {
+        munmap(layout, sizeof(Layout));
+    }
+}
+
+void HealthHistory::initializeHeader(FileHeader& header) {
+    header.version = kHistoryVersion;
+    header.recordSize = sizeof(ModuleRecord);
+    header.capacity = kMaxModules;
+    header.recentSamples = kRecentSamples;
+    header.minuteRollups = kMinuteRollups;
+    header.hourRollups = kHourRollups;
+    header.magic = kHistoryMagic;
+}
+
+bool HealthHistory::attachFile(const std::string& path) {
+    auto& logger = Logger::getInstance();
+    std::lock_guard<std::mutex> lock(historyMutex);
+    if (!layout) {
+        return false;
+    }
+    if (!filePath.empty()) {
+        logger.warning("Health history already backed by " + filePath, "HealthHistory");
+        return false;
+    }
+
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        logger.error("Cannot open health history file " + path + ": " + strerror(errno), "HealthHistory");
+        return false;
+    }
+    struct stat info;
+    FileHeader header{};
+    bool existing = fstat(fd, &info) == 0 && info.st_size > 0;
+    bool compatible = existing && static_cast<size_t>(info.st_size) == sizeof(Layout) &&
+                      pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                      header.magic == kHistoryMagic && header.version == kHistoryVersion &&
+                      header.recordSize == sizeof(ModuleRecord) && header.capacity == kMaxModules &&
+                      header.recentSamples == kRecentSamples && header.minuteRollups == kMinuteRollups &&
+                      header.hourRollups == kHourRollups;
+    if (existing && !compatible) {
+        logger.warning("Health history file " + path + " has an incompatible layout - starting over",
+                       "HealthHistory");
+    }
+
+    // Truncating first leaves a sparse, all-zero file
+    void* mapping = MAP_FAILED;
+    if (compatible || (ftruncate(fd, 0) == 0 && ftruncate(fd, sizeof(Layout)) == 0)) {
+        mapping = mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        logger.error("Cannot map health history file " + path + ": " + strerror(errno), "HealthHistory");
+        return false;
+    }
+
+    auto* fileLayout = static_cast<Layout*>(mapping);
+    if (!compatible) {
+        // Only records that were ever used are copied; the rest stays sparse
+        for (size_t i = 0; i < usedRecords; i++) {
+            memcpy(static_cast<void*>(&fileLayout->modules[i]), &layout->modules[i], sizeof(ModuleRecord));
+        }
+        initializeHeader(fileLayout->header);
+    }
+
+    munmap(layout, sizeof(Layout));
+    layout = fileLayout;
+    filePath = path;
+    rebuildIndex();
+
+    if (compatible) {
+        logger.info("Health history restored from " + path + " (" + std::to_string(usedRecords) + " modules)",
+                    "HealthHistory");
+    } else {
+        logger.info("Health history backed by " + path, "HealthHistory");
+    }
+    return true;
+}
+
+std::string HealthHistory::getFilePath() const {
+    std::lock_guard<std::mutex> lock(historyMutex);
+    return filePath;
+}
+
+// Records are claimed front to back, so the first unnamed one ends the scan
+void HealthHistory::rebuildIndex() {
+    index.clear();
+    usedRecords = 0;
+    while (usedRecords < kMaxModules && layout->modules[usedRecords].name[0] != '\0') {
+        ModuleRecord& record = layout->modules[usedRecords];
+        record.name[kNameLength - 1] = '\0';
+        index.emplace(record.name, usedRecords);
+        usedRecords++;
+    }
+}
+
+// Caller must hold historyMutex
+HealthHistory::ModuleRecord* HealthHistory::findOrClaim(const std::string& moduleName) {
+    auto it = index.find(moduleName.substr(0, kNameLength - 1));
+    if (it != index.end()) {
+        return &layout->modules[it->second];
+    }
+    if (usedRecords == kMaxModules || moduleName.empty()) {
+        return nullptr;
+    }
+
+    ModuleRecord& record = layout->modules[usedRecords];
+    memset(static_cast<void*>(&record), 0, sizeof(ModuleRecord));
+    strncpy(record.name, moduleName.c_str(), kNameLength - 1);
+    index.emplace(record.name, usedRecords);
+    usedRecords++;
+    return &record;
+}
+
+void HealthHistory::addToRollup(HealthRollup* ring, size_t capacity, uint64_t& count,
+                                int64_t bucketNs, const HealthSample& sample, bool statusChanged) {
+    int64_t startNs = sample.timeNs - sample.timeNs % bucketNs;
+    HealthRollup* bucket = count ? &ring[(count - 1) % capacity] : nullptr;
+    if (!bucket || bucket->startNs != startNs) {
+        bucket = &ring[count % capacity];
+        count++;
+        memset(static_cast<void*>(bucket), 0, sizeof(HealthRollup));
+        bucket->startNs = startNs;
+    }
+
+    bucket->samples++;
+    if (sample.status >= kUnhealthyStatus) {
+        bucket->failures++;
+    }
+    if (statusChanged) {
+        bucket->statusChanges++;
+    }
+    bucket->worstStatus = std::max<uint32_t>(bucket->worstStatus, sample.status);
+    if (sample.responseTimeMs >= 0) {
+        if (bucket->timedSamples == 0) {
+            bucket->minResponseMs = bucket->maxResponseMs = sample.responseTimeMs;
+        } else {
+            bucket->minResponseMs = std::min(bucket->minResponseMs, sample.responseTimeMs);
+            bucket->maxResponseMs = std::max(bucket->maxResponseMs, sample.responseTimeMs);
+        }
+        bucket->timedSamples++;
+        bucket->sumResponseMs += sample.responseTimeMs;
+    }
+}
+
+void HealthHistory::record(const std::string& moduleName, const HealthSample& sample) {
+    std::lock_guard<std::mutex> lock(historyMutex);
+    if (!layout) {
+        return;
+    }
+    ModuleRecord* record = findOrClaim(moduleName);
+    if (!record) {
+        return;
+    }
+
+    bool statusChanged = record->recentCount > 0 && record->lastStatus != sample.status;
+    record->recent[record->recentCount % kRecentSamples] = sample;
+    record->recentCount++;
+    record->lastStatus = sample.status;
+
+    addToRollup(record->minutes, kMinuteRollups, record->minuteCount, kMinuteNs, sample, statusChanged);
+    addToRollup(record->hours, kHourRollups, record->hourCount, kHourNs, sample, statusChanged);
+}
+
+HealthHistoryView HealthHistory::get(const std::string& moduleName) const {
+    HealthHistoryView view;
+    std::lock_guard<std::mutex> lock(historyMutex);
+    auto it = index.find(moduleName.substr(0, kNameLength - 1));
+    if (!layout || it == index.end()) {
+        return view;
+    }
+    const ModuleRecord& record = layout->modules[it->second];
+
+    auto copyRing = [](const auto* ring, size_t capacity, uint64_t count, auto& out) {
+        size_t size = static_cast<size_t>(std::min<uint64_t>(count, capacity));
+        out.reserve(size);
+        for (uint64_t i = count - size; i < count; i++) {
+            out.push_back(ring[i % capacity]);
+        }
+    };
+    copyRing(record.recent, kRecentSamples, record.recentCount, view.recent);
+    copyRing(record.minutes, kMinuteRollups, record.minuteCount, view.minutes);
+    copyRing(record.hours, kHourRollups, record.hourCount, view.hours);
+    return view;
+}
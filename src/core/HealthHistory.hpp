@@ -0,0 +1,108 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One health result as kept in history (16 bytes)
+struct HealthSample {
+    int64_t timeNs;               // system clock, so it survives restarts
+    float responseTimeMs;         // < 0 when the check timed out or threw
+    uint16_t consecutiveFailures; // saturates at 65535
+    uint8_t status;               // HealthMonitor::HealthStatus
+    uint8_t reserved;
+};
+
+// Downsampled bucket of samples
+struct HealthRollup {
+    int64_t startNs;              // bucket start, system clock
+    uint32_t samples;
+    uint32_t failures;            // UNHEALTHY or CRITICAL results
+    uint32_t statusChanges;       // flapping shows up here
+    uint32_t timedSamples;        // samples with a response time
+    float minResponseMs;
+    float maxResponseMs;
+    double sumResponseMs;
+    uint32_t worstStatus;
+    uint32_t reserved;
+
+    double meanResponseMs() const { return timedSamples ? sumResponseMs / timedSamples : 0.0; }
+};
+
+// Copy of one module's history, oldest entry first
+struct HealthHistoryView {
+    std::vector<HealthSample> recent;
+    std::vector<HealthRollup> minutes;
+    std::vector<HealthRollup> hours;
+};
+
+// Fixed-size per-module history: a ring of recent results plus 1-minute and
+// 1-hour rollup rings. All records live in one mapping sized for every
+// possible module up front, so memory is bounded no matter the uptime, and
+// only pages of modules that record anything are ever touched. The mapping
+// is anonymous, or a file so history survives restarts (records are matched
+// by module name, not ID). Thread-safe.
+class HealthHistory {
+public:
+    static constexpr size_t kMaxModules = 1024;
+    static constexpr size_t kNameLength = 64;
+    static constexpr size_t kRecentSamples = 256;
+    static constexpr size_t kMinuteRollups = 120; // two hours
+    static constexpr size_t kHourRollups = 168;   // one week
+
+    HealthHistory();
+    ~HealthHistory();
+
+    // Move history into a file mapping. An existing compatible file is
+    // adopted (its history replaces what is in memory); otherwise the file
+    // is created and seeded with the current history. False on error.
+    bool attachFile(const std::string& path);
+    std::string getFilePath() const;
+
+    void record(const std::string& moduleName, const HealthSample& sample);
+    HealthHistoryView get(const std::string& moduleName) const;
+
+    HealthHistory(const HealthHistory&) = delete;
+    HealthHistory& operator=(const HealthHistory&) = delete;
+
+private:
+    struct ModuleRecord {
+        char name[kNameLength];
+        uint64_t recentCount; // ever recorded; next slot is recentCount % kRecentSamples
+        uint64_t minuteCount; // buckets ever opened
+        uint64_t hourCount;
+        uint32_t lastStatus;
+        uint32_t reserved;
+        HealthSample recent[kRecentSamples];
+        HealthRollup minutes[kMinuteRollups];
+        HealthRollup hours[kHourRollups];
+    };
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t recordSize;
+        uint32_t capacity;
+        uint32_t recentSamples;
+        uint32_t minuteRollups;
+        uint32_t hourRollups;
+        uint32_t reserved;
+    };
+    struct Layout {
+        FileHeader header;
+        ModuleRecord modules[kMaxModules];
+    };
+
+    ModuleRecord* findOrClaim(const std::string& moduleName);
+    void rebuildIndex();
+    static void addToRollup(HealthRollup* ring, size_t capacity, uint64_t& count,
+                            int64_t bucketNs, const HealthSample& sample, bool statusChanged);
+    static void initializeHeader(FileHeader& header);
+
+    mutable std::mutex historyMutex;
+    Layout* layout;
+    std::string filePath;
+    std::unordered_map<std::string, size_t> index; // name -> record
+    size_t usedRecords;
+};
@@ -1,16 +1,69 @@
 #include "HealthMonitor.hpp"
 #include "ModuleManager.hpp"
+#include "MetricsSegment.hpp"
+#include "ModuleCallScope.hpp"
+#include "../utils/BinaryLog.hpp"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static_assert(metrics_segment::kOperationCount == HealthMonitor::kLatencyOperationCount,
+              "Metrics segment layout out of sync with LatencyOperation");
+static_assert(metrics_segment::kMaxModules >= HealthMonitor::kMaxTrackedModules,
+              "Metrics segment cannot hold every module ID");
+static_assert(ModuleCallScope::kMaxModules == HealthMonitor::kMaxTrackedModules,
+              "ModuleCallScope and HealthMonitor disagree on module IDs");
+static_assert(ModuleCallScope::kNoModule == HealthMonitor::kInvalidModuleId,
+              "ModuleCallScope and HealthMonitor disagree on the invalid ID");
 
 // Initialize static member
 HealthMonitor* HealthMonitor::instance = nullptr;
 
 HealthMonitor::HealthMonitor() 
     : monitoring(false),
-      checkInterval(std::chrono::seconds(10)),
       failureThreshold(3),
-      systemHealth(HealthStatus::HEALTHY) {
+      wakePending(false),
+      checkInterval(std::chrono::seconds(10)),
+      nextSystemUpdate(std::chrono::steady_clock::now()),
+      checkJitter(0.1),
+      nextTimerId(1),
+      jitterRng(std::random_device{}()),
+      moduleIdCount(0),
+      moduleLatency(new std::unique_ptr<ModuleLatency>[kMaxTrackedModules]),
+      lastOperationNs(new std::atomic<int64_t>[kMaxTrackedModules]()),
+      moduleBaselines(new ModuleBaselines[kMaxTrackedModules]),
+      degradationPolicy(std::make_shared<LatencyBaseline::Policy>()),
+      heartbeatSlots(new HeartbeatSlot[kMaxHeartbeatSlots]),
+      heartbeatHighWater(0),
+      heartbeatOwners(kMaxHeartbeatSlots),
+      heartbeatTimeoutNs(0),
+      checkWorkers(std::min(4u, std::max(2u, std::thread::hardware_concurrency()))),
+      checkTimeoutNs(std::chrono::nanoseconds(std::chrono::seconds(1)).count()),
+      checkBudget(0.0),
+      budgetTokens(0.0),
+      budgetRefill(std::chrono::steady_clock::now()),
+      nextDeferredCheck(std::chrono::steady_clock::time_point::max()),
+      checksStarted(0),
+      checksDeferred(0),
+      detections(0),
+      achievedCheckRate(0.0),
+      rateSampleChecks(0),
+      rateSampleTime(std::chrono::steady_clock::now()),
+      systemHealth(HealthStatus::UNHEALTHY),
+      nextRemediationDue(std::chrono::steady_clock::time_point::max()),
+      latestMetrics(std::make_shared<MetricsSnapshot>()),
+      metricsPublishInterval(std::chrono::seconds(1)),
+      nextMetricsPublish(std::chrono::steady_clock::now()),
+      metricsSegment(nullptr) {
+    for (auto& count : statusCounts) {
+        count.store(0, std::memory_order_relaxed);
+    }
     
     auto& logger = Logger::getInstance();
     logger.info("Health Monitor initialized", "HealthMonitor");
@@ -35,10 +88,19 @@ void HealthMonitor::startMonitoring() {
         return;
     }
 
+    std::chrono::milliseconds interval;
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex);
+        interval = checkInterval;
+        nextSystemUpdate = std::chrono::steady_clock::now();
+    }
+
     auto& logger = Logger::getInstance();
     logger.info("Starting health monitoring with interval: " + 
-                std::to_string(checkInterval.count()) + "s", "HealthMonitor");
+                std::to_string(interval.count()) + "ms", "HealthMonitor");
 
+    checkPool = std::make_unique<WorkerPool>(checkWorkers.load());
+    remediationPool = std::make_unique<WorkerPool>(1); // one remediation at a time
     monitoring = true;
     monitorThread = std::thread(&HealthMonitor::monitoringLoop, this);
 }
@@ -51,97 +113,443 @@ void HealthMonitor::stopMonitoring() {
     auto& logger = Logger::getInstance();
     logger.info("Stopping health monitoring", "HealthMonitor");
 
-    monitoring = false;
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        monitoring = false;
+    }
+    wakeCondition.notify_all(); // no waiting out the current interval
     if (monitorThread.joinable()) {
         monitorThread.join();
     }
+
+    // Workers stuck in a hung check are detached, not waited for
+    checkPool->shutdown();
+    checkPool.reset();
+    pendingChecks.clear();
+
+    // Queued remediations are dropped; a running one may finish detached
+    remediationPool->shutdown();
+    remediationPool.reset();
+    std::lock_guard<std::mutex> lock(healthMutex);
+    for (auto& [moduleName, state] : remediationStates) {
+        state.inFlight = false;
+    }
 }
 
 bool HealthMonitor::isMonitoring() const {
     return monitoring;
 }
 
+void HealthMonitor::wakeMonitor() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wakePending = true;
+    }
+    wakeCondition.notify_one();
+}
+
 void HealthMonitor::monitoringLoop() {
     auto& logger = Logger::getInstance();
-    logger.debug("Health monitor loop started", "HealthMonitor");
+    HOTSWAP_LOG_DEBUG("HealthMonitor", "Health monitor loop started");
 
     while (monitoring) {
+        auto now = std::chrono::steady_clock::now();
+        bool systemUpdateDue;
+        bool metricsPublishDue;
+        {
+            std::lock_guard<std::mutex> lock(schedulerMutex);
+            systemUpdateDue = now >= nextSystemUpdate;
+            if (systemUpdateDue) {
+                nextSystemUpdate = now + checkInterval;
+            }
+            metricsPublishDue = now >= nextMetricsPublish;
+            if (metricsPublishDue) {
+                nextMetricsPublish = now + metricsPublishInterval;
+            }
+        }
+
         try {
-            performHealthChecks();
-            updateSystemHealth();
-            checkForAlerts();
-            logHealthStatus();
+            scanHeartbeats();
+            expireOverdueChecks(now);
+            performHealthChecks(collectDueChecks(now));
+            planRemediation(now);
+            if (systemUpdateDue) {
+                checkForAlerts();
+                logHealthStatus();
+            }
+            if (metricsPublishDue) {
+                publishMetricsSnapshot();
+            }
         } catch (const std::exception& e) {
             logger.error("Health monitor exception: " + std::string(e.what()), "HealthMonitor");
         }
 
-        // run runtime shared-library scan and log results
-        ModuleManager::getInstance().scanAndLogRuntimeSharedLibraries();
+        if (systemUpdateDue) {
+            // run runtime shared-library scan and log results
+            ModuleManager::getInstance().scanAndLogRuntimeSharedLibraries();
+        }
 
-        std::this_thread::sleep_for(std::chrono::seconds(5));
+        // Sleep until the next check is due, or until woken/stopped
+        std::chrono::steady_clock::time_point wakeAt;
+        {
+            std::lock_guard<std::mutex> lock(schedulerMutex);
+            wakeAt = std::min({checkWheel.nextExpiry(), nextSystemUpdate, nextMetricsPublish});
+        }
+        wakeAt = std::min({wakeAt, nextCheckDeadline(), nextRemediationDue, nextDeferredCheck});
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait_until(lock, wakeAt, [this] { return !monitoring || wakePending; });
+        wakePending = false;
     }
 
-    logger.debug("Health monitor loop stopped", "HealthMonitor");
+    HOTSWAP_LOG_DEBUG("HealthMonitor", "Health monitor loop stopped");
 }
 
-void HealthMonitor::performHealthChecks() {
+std::vector<std::string> HealthMonitor::collectDueChecks(std::chrono::steady_clock::time_point now) {
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+
+    std::vector<uint64_t> expired;
+    checkWheel.advance(now, expired);
+
+    std::vector<std::string> dueModules;
+    dueModules.reserve(expired.size());
+    for (uint64_t timerId : expired) {
+        auto it = timerOwners.find(timerId);
+        if (it == timerOwners.end()) {
+            continue;
+        }
+        dueModules.push_back(it->second);
+        timerOwners.erase(it);
+        scheduleCheck(dueModules.back(), false);
+    }
+    return dueModules;
+}
+
+// Caller must hold schedulerMutex
+void HealthMonitor::scheduleCheck(const std::string& moduleName, bool initial) {
+    auto& entry = scheduledChecks[moduleName];
+    if (entry.timerId != 0) {
+        checkWheel.cancel(entry.timerId);
+        timerOwners.erase(entry.timerId);
+    }
+
+    auto interval = entry.interval;
+    if (interval.count() <= 0) {
+        double stretch = adaptivePolicy.enabled ? entry.stretch : 1.0;
+        interval = std::chrono::milliseconds(static_cast<int64_t>(checkInterval.count() * stretch));
+    }
+    interval = std::max(interval, std::chrono::milliseconds(1));
+
+    // First check lands anywhere in the interval so modules registered
+    // together don't all fire on the same tick; later ones get +/- jitter.
+    double factor;
+    if (initial) {
+        factor = std::uniform_real_distribution<double>(0.0, 1.0)(jitterRng);
+    } else {
+        factor = 1.0 + std::uniform_real_distribution<double>(-checkJitter, checkJitter)(jitterRng);
+    }
+    auto delay = std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval * factor);
+
+    entry.timerId = nextTimerId++;
+    timerOwners[entry.timerId] = moduleName;
+    checkWheel.schedule(entry.timerId, std::chrono::steady_clock::now() + delay);
+}
+
+// Caller must hold schedulerMutex
+void HealthMonitor::unscheduleCheck(const std::string& moduleName, bool forgetInterval) {
+    auto it = scheduledChecks.find(moduleName);
+    if (it == scheduledChecks.end()) {
+        return;
+    }
+    if (it->second.timerId != 0) {
+        checkWheel.cancel(it->second.timerId);
+        timerOwners.erase(it->second.timerId);
+        it->second.timerId = 0;
+    }
+    if (forgetInterval) {
+        scheduledChecks.erase(it);
+    }
+}
+
+void HealthMonitor::performHealthChecks(const std::vector<std::string>& dueModules) {
+    auto now = std::chrono::steady_clock::now();
+    if (now - rateSampleTime >= std::chrono::seconds(1)) {
+        uint64_t started = checksStarted.load(std::memory_order_relaxed);
+        std::chrono::duration<double> elapsed = now - rateSampleTime;
+        achievedCheckRate.store((started - rateSampleChecks) / elapsed.count(), std::memory_order_relaxed);
+        rateSampleChecks = started;
+        rateSampleTime = now;
+    }
+
+    // Checks held back by the budget go first, in the order they came due
+    std::vector<std::string> candidates(deferredChecks.begin(), deferredChecks.end());
+    deferredChecks.clear();
+    nextDeferredCheck = std::chrono::steady_clock::time_point::max();
+    for (const auto& moduleName : dueModules) {
+        if (std::find(candidates.begin(), candidates.end(), moduleName) == candidates.end()) {
+            candidates.push_back(moduleName);
+        }
+    }
+    if (candidates.empty()) {
+        return;
+    }
+
+    // Copy the check functions out - module code never runs under healthMutex
+    std::vector<std::pair<std::string, std::function<bool()>>> checks;
+    {
+        std::lock_guard<std::mutex> lock(healthMutex);
+        checks.reserve(candidates.size());
+        for (const auto& moduleName : candidates) {
+            auto checkIt = healthChecks.find(moduleName);
+            if (checkIt != healthChecks.end()) {
+                checks.emplace_back(moduleName, checkIt->second);
+            }
+        }
+    }
+
+    auto timeout = std::chrono::nanoseconds(checkTimeoutNs.load(std::memory_order_relaxed));
+
+    for (auto& [moduleName, checkFunction] : checks) {
+        auto pendingIt = pendingChecks.find(moduleName);
+        if (pendingIt != pendingChecks.end() &&
+            !pendingIt->second->finished.load(std::memory_order_acquire)) {
+            // Previous check is still stuck in module code - don't pile up
+            // another call, just count one more failure if it already overran
+            if (pendingIt->second->timedOut) {
+                recordCheckTimeout(moduleName, timeout);
+            }
+            continue;
+        }
+
+        if (!takeCheckToken(now)) {
+            deferredChecks.push_back(moduleName);
+            checksDeferred.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        auto pending = std::make_shared<PendingCheck>();
+        pending->deadline = now + timeout;
+        pendingChecks[moduleName] = pending;
+
+        checkPool->submit([this, moduleName = moduleName, checkFunction = std::move(checkFunction), pending]() {
+            runHealthCheck(moduleName, checkFunction, pending);
+        });
+        checksStarted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (!deferredChecks.empty()) {
+        double rate = checkBudget.load(std::memory_order_relaxed);
+        nextDeferredCheck = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                      std::chrono::duration<double>((1.0 - budgetTokens) / rate));
+    }
+}
+
+// Monitor thread: token bucket holding at most 100ms of budget, so a burst
+// after an idle period cannot blow through the cap
+bool HealthMonitor::takeCheckToken(std::chrono::steady_clock::time_point now) {
+    double rate = checkBudget.load(std::memory_order_relaxed);
+    if (rate <= 0.0) {
+        return true;
+    }
+
+    std::chrono::duration<double> elapsed = now - budgetRefill;
+    budgetRefill = now;
+    budgetTokens = std::min(std::max(rate * 0.1, 1.0), budgetTokens + elapsed.count() * rate);
+    if (budgetTokens < 1.0) {
+        return false;
+    }
+    budgetTokens -= 1.0;
+    return true;
+}
+
+// Caller must hold healthMutex. Feeds detection stats and adaptive intervals.
+void HealthMonitor::noteCheckOutcome(const std::string& moduleName, const HealthCheckResult& previous,
+                                     const HealthCheckResult& current) {
+    auto passing = [](HealthStatus status) {
+        return status == HealthStatus::HEALTHY || status == HealthStatus::DEGRADED;
+    };
+    bool failing = !passing(current.status);
+    if (passing(previous.status) && failing) {
+        detections.fetch_add(1, std::memory_order_relaxed);
+        auto interval = std::chrono::duration_cast<std::chrono::nanoseconds>(current.lastCheck - previous.lastCheck);
+        checkIntervalAtDetection.record(static_cast<uint64_t>(std::max<int64_t>(0, interval.count())));
+    }
+
+    std::lock_guard<std::mutex> scheduleLock(schedulerMutex);
+    auto it = scheduledChecks.find(moduleName);
+    if (!adaptivePolicy.enabled || it == scheduledChecks.end() || it->second.interval.count() > 0) {
+        return; // pinned interval
+    }
+
+    ScheduledCheck& entry = it->second;
+    if (current.status == HealthStatus::HEALTHY) {
+        if (++entry.healthyStreak >= adaptivePolicy.stableChecks) {
+            entry.healthyStreak = 0;
+            entry.stretch = std::min(entry.stretch * adaptivePolicy.growth, adaptivePolicy.maxFactor);
+        }
+        return;
+    }
+
+    entry.healthyStreak = 0;
+    if (failing && entry.stretch > adaptivePolicy.minFactor) {
+        // Tighten sharply and pull the already scheduled check forward
+        entry.stretch = adaptivePolicy.minFactor;
+        if (entry.timerId != 0) {
+            scheduleCheck(moduleName, false);
+        }
+    }
+}
+
+// Runs on a pool worker
+void HealthMonitor::runHealthCheck(const std::string& moduleName,
+                                   const std::function<bool()>& checkFunction,
+                                   const std::shared_ptr<PendingCheck>& pending) {
+    auto startTime = std::chrono::steady_clock::now();
+    bool isHealthy = false;
+    std::string error;
+
+    try {
+        isHealthy = checkFunction();
+    } catch (const std::exception& e) {
+        error = e.what();
+    } catch (...) {
+        error = "unknown exception";
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+
+    // Only publish if the monitor hasn't already given up on this check
+    uint32_t expected = PendingCheck::RUNNING;
+    if (pending->state.compare_exchange_strong(expected, PendingCheck::COMPLETED)) {
+        applyCheckResult(moduleName, isHealthy, error, startTime, endTime);
+    }
+    pending->finished.store(true, std::memory_order_release);
+}
+
+void HealthMonitor::applyCheckResult(const std::string& moduleName, bool isHealthy,
+                                     const std::string& error,
+                                     std::chrono::steady_clock::time_point startTime,
+                                     std::chrono::steady_clock::time_point endTime) {
     std::lock_guard<std::mutex> lock(healthMutex);
     auto& logger = Logger::getInstance();
 
-    for (auto& [moduleName, checkFunction] : healthChecks) {
-        auto startTime = std::chrono::steady_clock::now();
-        
-        try {
-            bool isHealthy = checkFunction();
-            auto endTime = std::chrono::steady_clock::now();
-            auto responseTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+    auto statusIt = healthStatus.find(moduleName);
+    if (statusIt == healthStatus.end()) {
+        return; // unregistered while the check was running
+    }
 
-            HealthCheckResult result;
-            result.lastCheck = endTime;
-            result.responseTimeMs = responseTime.count();
+    auto responseTime = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime);
+    ModuleId moduleId = findModuleId(moduleName);
+    if (auto* histogram = latencyHistogram(moduleId, LatencyOperation::HEALTH_CHECK)) {
+        histogram->record(static_cast<uint64_t>(responseTime.count()));
+    }
+    bool checkDrifting = error.empty() && updateBaseline(moduleId, BaselineKind::HEALTH_CHECK, responseTime);
 
-            if (isHealthy) {
-                result.status = HealthStatus::HEALTHY;
-                result.message = "Module is healthy";
-                result.consecutiveFailures = 0;
-                
-                logger.debug("Health check passed: " + moduleName + 
-                            " (response: " + std::to_string(responseTime.count()) + "ms)", "HealthMonitor");
-            } else {
-                result.consecutiveFailures = healthStatus[moduleName].consecutiveFailures + 1;
-                
-                if (result.consecutiveFailures >= failureThreshold) {
-                    result.status = HealthStatus::CRITICAL;
-                    result.message = "Module critically unhealthy - " + 
-                                   std::to_string(result.consecutiveFailures) + " consecutive failures";
-                    
-                    logger.error("Critical health failure: " + moduleName, "HealthMonitor");
-                } else {
-                    result.status = HealthStatus::UNHEALTHY;
-                    result.message = "Module unhealthy - " + 
-                                   std::to_string(result.consecutiveFailures) + " consecutive failures";
-                    
-                    logger.warning("Health check failed: " + moduleName, "HealthMonitor");
-                }
-            }
-            
-            healthStatus[moduleName] = result;
+    HealthCheckResult result;
+    result.lastCheck = endTime;
+    result.responseTimeMs = responseTime.count() / 1e6;
 
-        } catch (const std::exception& e) {
-            HealthCheckResult result;
-            result.status = HealthStatus::CRITICAL;
-            result.message = "Health check exception: " + std::string(e.what());
-            result.lastCheck = std::chrono::steady_clock::now();
-            result.consecutiveFailures = healthStatus[moduleName].consecutiveFailures + 1;
-            result.responseTimeMs = -1;
+    if (!error.empty()) {
+        result.status = HealthStatus::CRITICAL;
+        result.message = "Health check exception: " + error;
+        result.consecutiveFailures = statusIt->second.consecutiveFailures + 1;
+        result.responseTimeMs = -1;
 
-            healthStatus[moduleName] = result;
+        logger.error("Health check exception for " + moduleName + ": " + error, "HealthMonitor");
+    } else if (isHealthy && (checkDrifting || isLatencyDegraded(moduleId))) {
+        // Up, but much slower than it has learned to be
+        LatencyBaseline baseline = getLatencyBaseline(moduleName, BaselineKind::HEALTH_CHECK);
+        result.status = HealthStatus::DEGRADED;
+        result.message = "Check latency degraded - recent " +
+                         std::to_string(static_cast<int64_t>(baseline.recentNs / 1000)) + "us vs baseline " +
+                         std::to_string(static_cast<int64_t>(baseline.meanNs / 1000)) + "us";
+        result.consecutiveFailures = 0;
+
+        logger.warning("Latency degraded: " + moduleName + " (" + result.message + ")", "HealthMonitor");
+    } else if (isHealthy) {
+        result.status = HealthStatus::HEALTHY;
+        result.message = "Module is healthy";
+        result.consecutiveFailures = 0;
+        
+        HOTSWAP_LOG_FMT(Logger::Level::DEBUG, "HealthMonitor", "Health check passed: {} (response: {}us)",
+                        moduleName, responseTime.count() / 1000);
+    } else {
+        result.consecutiveFailures = statusIt->second.consecutiveFailures + 1;
+        
+        if (result.consecutiveFailures >= failureThreshold) {
+            result.status = HealthStatus::CRITICAL;
+            result.message = "Module critically unhealthy - " + 
+                           std::to_string(result.consecutiveFailures) + " consecutive failures";
             
-            logger.error("Health check exception for " + moduleName + ": " + e.what(), "HealthMonitor");
+            logger.error("Critical health failure: " + moduleName, "HealthMonitor");
+        } else {
+            result.status = HealthStatus::UNHEALTHY;
+            result.message = "Module unhealthy - " + 
+                           std::to_string(result.consecutiveFailures) + " consecutive failures";
+            
+            logger.warning("Health check failed: " + moduleName, "HealthMonitor");
+        }
+    }
+    
+    noteCheckOutcome(moduleName, statusIt->second, result);
+    storeModuleStatus(moduleName, result);
+}
+
+void HealthMonitor::recordCheckTimeout(const std::string& moduleName, std::chrono::nanoseconds timeout) {
+    std::lock_guard<std::mutex> lock(healthMutex);
+    auto& logger = Logger::getInstance();
+
+    auto statusIt = healthStatus.find(moduleName);
+    if (statusIt == healthStatus.end()) {
+        return;
+    }
+
+    HealthCheckResult result;
+    result.lastCheck = std::chrono::steady_clock::now();
+    result.responseTimeMs = -1;
+    result.consecutiveFailures = statusIt->second.consecutiveFailures + 1;
+    result.status = result.consecutiveFailures >= failureThreshold
+                        ? HealthStatus::CRITICAL : HealthStatus::UNHEALTHY;
+    result.message = "Health check timed out after " +
+                     std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count()) +
+                     "ms - " + std::to_string(result.consecutiveFailures) + " consecutive failures";
+
+    logger.warning("Health check timed out: " + moduleName, "HealthMonitor");
+    noteCheckOutcome(moduleName, statusIt->second, result);
+    storeModuleStatus(moduleName, result);
+}
+
+// Monitor thread: mark checks that overran their deadline, drop finished ones
+void HealthMonitor::expireOverdueChecks(std::chrono::steady_clock::time_point now) {
+    auto timeout = std::chrono::nanoseconds(checkTimeoutNs.load(std::memory_order_relaxed));
+
+    for (auto it = pendingChecks.begin(); it != pendingChecks.end();) {
+        auto& pending = it->second;
+        if (pending->finished.load(std::memory_order_acquire)) {
+            it = pendingChecks.erase(it);
+            continue;
+        }
+
+        if (!pending->timedOut && now >= pending->deadline) {
+            uint32_t expected = PendingCheck::RUNNING;
+            if (pending->state.compare_exchange_strong(expected, PendingCheck::TIMED_OUT)) {
+                pending->timedOut = true;
+                recordCheckTimeout(it->first, timeout);
+            }
         }
+        ++it;
     }
 }
 
+std::chrono::steady_clock::time_point HealthMonitor::nextCheckDeadline() const {
+    auto earliest = std::chrono::steady_clock::time_point::max();
+    for (const auto& [moduleName, pending] : pendingChecks) {
+        if (!pending->timedOut && !pending->finished.load(std::memory_order_relaxed)) {
+            earliest = std::min(earliest, pending->deadline);
+        }
+    }
+    return earliest;
+}
+
 void HealthMonitor::registerModule(const std::string& moduleName, 
                                   std::function<bool()> healthCheckFunction) {
     std::lock_guard<std::mutex> lock(healthMutex);
@@ -149,8 +557,66 @@ void HealthMonitor::registerModule(const std::string& moduleName,
     auto& logger = Logger::getInstance();
     logger.info("Registering health check for module: " + moduleName, "HealthMonitor");
 
+    releaseHeartbeatSlot(moduleName); // polled modules don't keep a slot
     healthChecks[moduleName] = healthCheckFunction;
-    
+    initializeModuleState(moduleName);
+
+    {
+        std::lock_guard<std::mutex> scheduleLock(schedulerMutex);
+        // Fresh or just swapped in - watch it closely until it proves stable
+        auto& entry = scheduledChecks[moduleName];
+        entry.stretch = adaptivePolicy.enabled ? adaptivePolicy.minFactor : 1.0;
+        entry.healthyStreak = 0;
+        scheduleCheck(moduleName, true);
+    }
+    wakeMonitor();
+}
+
+HeartbeatSlot* HealthMonitor::registerHeartbeatModule(const std::string& moduleName) {
+    std::lock_guard<std::mutex> lock(healthMutex);
+
+    auto& logger = Logger::getInstance();
+
+    size_t index;
+    auto existing = heartbeatIndex.find(moduleName);
+    if (existing != heartbeatIndex.end()) {
+        index = existing->second;
+    } else if (!freeHeartbeatSlots.empty()) {
+        index = freeHeartbeatSlots.back();
+        freeHeartbeatSlots.pop_back();
+    } else if (heartbeatHighWater.load(std::memory_order_relaxed) < kMaxHeartbeatSlots) {
+        index = heartbeatHighWater.load(std::memory_order_relaxed);
+    } else {
+        logger.warning("No free heartbeat slot for module: " + moduleName, "HealthMonitor");
+        return nullptr;
+    }
+
+    HOTSWAP_LOG_DEBUG("HealthMonitor", "Registering heartbeat for module: " + moduleName +
+                      " (slot " + std::to_string(index) + ")");
+
+    HeartbeatSlot& slot = heartbeatSlots[index];
+    slot.beat(HeartbeatSlot::HEALTHY); // grace period starts now
+    slot.observed.store(HeartbeatSlot::UNOBSERVED, std::memory_order_relaxed);
+    slot.moduleId.store(getModuleId(moduleName), std::memory_order_relaxed);
+    slot.active.store(1, std::memory_order_release);
+
+    heartbeatOwners[index] = moduleName;
+    heartbeatIndex[moduleName] = index;
+    if (index == heartbeatHighWater.load(std::memory_order_relaxed)) {
+        heartbeatHighWater.store(index + 1, std::memory_order_release);
+    }
+
+    healthChecks.erase(moduleName); // never polled
+    initializeModuleState(moduleName);
+    {
+        std::lock_guard<std::mutex> scheduleLock(schedulerMutex);
+        unscheduleCheck(moduleName, false);
+    }
+    return &slot;
+}
+
+// Caller must hold healthMutex
+void HealthMonitor::initializeModuleState(const std::string& moduleName) {
     // Initialize health status
     HealthCheckResult initialStatus;
     initialStatus.status = HealthStatus::HEALTHY;
@@ -159,12 +625,134 @@ void HealthMonitor::registerModule(const std::string& moduleName,
     initialStatus.consecutiveFailures = 0;
     initialStatus.responseTimeMs = 0;
     
-    healthStatus[moduleName] = initialStatus;
+    storeModuleStatus(moduleName, initialStatus);
+
+    // Metrics are keyed by a stable ID and survive re-registration; the
+    // latency baseline does not - a swapped-in version learns its own
+    resetLatencyBaseline(getModuleId(moduleName));
+}
+
+// Caller must hold healthMutex
+void HealthMonitor::releaseHeartbeatSlot(const std::string& moduleName) {
+    auto it = heartbeatIndex.find(moduleName);
+    if (it == heartbeatIndex.end()) {
+        return;
+    }
+
+    heartbeatSlots[it->second].active.store(0, std::memory_order_release);
+    heartbeatOwners[it->second].clear();
+    freeHeartbeatSlots.push_back(it->second);
+    heartbeatIndex.erase(it);
+}
+
+// Caller must hold schedulerMutex; no-op for heartbeat modules
+void HealthMonitor::scheduleImmediateCheck(const std::string& moduleName) {
+    auto it = scheduledChecks.find(moduleName);
+    if (it == scheduledChecks.end() || it->second.timerId == 0) {
+        return;
+    }
+    checkWheel.cancel(it->second.timerId);
+    timerOwners.erase(it->second.timerId);
 
-    // Initialize metrics
-    ModuleMetrics initialMetrics{};
-    initialMetrics.lastOperationTime = std::chrono::steady_clock::now();
-    moduleMetrics[moduleName] = initialMetrics;
+    it->second.timerId = nextTimerId++;
+    timerOwners[it->second.timerId] = moduleName;
+    checkWheel.schedule(it->second.timerId, std::chrono::steady_clock::now());
+}
+
+// Lock-free pass over the contiguous slot array. Steady healthy modules cost
+// a few loads each; the lock is only taken when something has to be published.
+void HealthMonitor::scanHeartbeats() {
+    struct Observation {
+        size_t index;
+        uint32_t status;
+        uint64_t beatNs;
+        bool stale;
+    };
+    std::vector<Observation> observations;
+
+    const uint64_t nowNs = HeartbeatSlot::nowNs();
+    const int64_t timeoutNs = heartbeatTimeoutNs.load(std::memory_order_relaxed);
+    const size_t count = heartbeatHighWater.load(std::memory_order_acquire);
+
+    for (size_t i = 0; i < count; i++) {
+        HeartbeatSlot& slot = heartbeatSlots[i];
+        if (!slot.active.load(std::memory_order_acquire)) {
+            continue;
+        }
+
+        uint64_t beatNs = slot.timestampNs.load(std::memory_order_acquire);
+        uint32_t status = slot.status.load(std::memory_order_relaxed);
+        bool stale = timeoutNs > 0 && nowNs > beatNs &&
+                     nowNs - beatNs > static_cast<uint64_t>(timeoutNs);
+        if (stale) {
+            status = HeartbeatSlot::UNHEALTHY;
+        } else if (status == HeartbeatSlot::HEALTHY &&
+                   isLatencyDegraded(slot.moduleId.load(std::memory_order_relaxed))) {
+            status = HeartbeatSlot::DRIFTING;
+        }
+
+        // Unchanged healthy/degraded modules need no publishing; unhealthy
+        // ones are republished so consecutive failures keep counting.
+        if (status == slot.observed.load(std::memory_order_relaxed) &&
+            status != HeartbeatSlot::UNHEALTHY) {
+            continue;
+        }
+        observations.push_back({i, status, beatNs, stale});
+    }
+
+    if (observations.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(healthMutex);
+    auto& logger = Logger::getInstance();
+
+    for (const auto& observation : observations) {
+        HeartbeatSlot& slot = heartbeatSlots[observation.index];
+        const std::string& moduleName = heartbeatOwners[observation.index];
+        if (moduleName.empty() || !slot.active.load(std::memory_order_relaxed)) {
+            continue; // released while we were scanning
+        }
+
+        HealthCheckResult result;
+        result.lastCheck = std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::nanoseconds(observation.beatNs)));
+        result.responseTimeMs = 0;
+
+        switch (observation.status) {
+            case HeartbeatSlot::HEALTHY:
+                result.status = HealthStatus::HEALTHY;
+                result.message = "Heartbeat healthy";
+                result.consecutiveFailures = 0;
+                break;
+            case HeartbeatSlot::DRIFTING:
+                result.status = HealthStatus::DEGRADED;
+                result.message = "Heartbeat healthy, call latency degraded";
+                result.consecutiveFailures = 0;
+                break;
+            case HeartbeatSlot::DEGRADED:
+                result.status = HealthStatus::DEGRADED;
+                result.message = "Module reports degraded (load: " +
+                                 std::to_string(slot.load.load(std::memory_order_relaxed)) + ")";
+                result.consecutiveFailures = 0;
+                logger.warning("Heartbeat degraded: " + moduleName, "HealthMonitor");
+                break;
+            default:
+                auto statusIt = healthStatus.find(moduleName);
+                result.consecutiveFailures =
+                    (statusIt != healthStatus.end() ? statusIt->second.consecutiveFailures : 0) + 1;
+                result.status = result.consecutiveFailures >= failureThreshold
+                                    ? HealthStatus::CRITICAL : HealthStatus::UNHEALTHY;
+                result.message = std::string(observation.stale ? "Missed heartbeat" : "Module reports unhealthy") +
+                                 " - " + std::to_string(result.consecutiveFailures) + " consecutive failures";
+                logger.warning("Heartbeat failure: " + moduleName, "HealthMonitor");
+                break;
+        }
+
+        storeModuleStatus(moduleName, result);
+        slot.observed.store(observation.status, std::memory_order_relaxed);
+    }
 }
 
 void HealthMonitor::unregisterModule(const std::string& moduleName) {
@@ -173,9 +761,14 @@ void HealthMonitor::unregisterModule(const std::string& moduleName) {
     auto& logger = Logger::getInstance();
     logger.info("Unregistering health check for module: " + moduleName, "HealthMonitor");
 
+    releaseHeartbeatSlot(moduleName);
     healthChecks.erase(moduleName);
-    healthStatus.erase(moduleName);
-    moduleMetrics.erase(moduleName);
+    {
+        std::lock_guard<std::mutex> scheduleLock(schedulerMutex);
+        unscheduleCheck(moduleName, true);
+    }
+    eraseModuleStatus(moduleName);
+    resetLatencyBaseline(findModuleId(moduleName));
 }
 
 HealthMonitor::HealthCheckResult HealthMonitor::getModuleHealth(const std::string& moduleName) const {
@@ -183,7 +776,17 @@ HealthMonitor::HealthCheckResult HealthMonitor::getModuleHealth(const std::strin
     
     auto it = healthStatus.find(moduleName);
     if (it != healthStatus.end()) {
-        return it->second;
+        HealthCheckResult result = it->second;
+
+        // Heartbeat modules only publish on change - report the latest beat
+        auto slotIt = heartbeatIndex.find(moduleName);
+        if (slotIt != heartbeatIndex.end()) {
+            uint64_t beatNs = heartbeatSlots[slotIt->second].timestampNs.load(std::memory_order_acquire);
+            result.lastCheck = std::chrono::steady_clock::time_point(
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::nanoseconds(beatNs)));
+        }
+        return result;
     }
     
     HealthCheckResult unknownStatus;
@@ -197,94 +800,670 @@ HealthMonitor::HealthCheckResult HealthMonitor::getModuleHealth(const std::strin
 }
 
 
+HealthMonitor::ModuleId HealthMonitor::getModuleId(const std::string& moduleName) {
+    std::lock_guard<std::mutex> lock(idMutex);
+
+    auto it = moduleIds.find(moduleName);
+    if (it != moduleIds.end()) {
+        return it->second;
+    }
+
+    uint32_t id = moduleIdCount.load(std::memory_order_relaxed);
+    if (id >= kMaxTrackedModules) {
+        Logger::getInstance().warning("Metrics table full, not tracking module: " + moduleName, "HealthMonitor");
+        return kInvalidModuleId;
+    }
+
+    // Everything indexed by the ID exists before anyone can record into it
+    moduleLatency[id] = std::make_unique<ModuleLatency>();
+    lastOperationNs[id].store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                              std::memory_order_relaxed);
+    moduleIds.emplace(moduleName, id);
+    moduleNames.push_back(moduleName);
+    moduleIdCount.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+HealthMonitor::ModuleId HealthMonitor::findModuleId(const std::string& moduleName) const {
+    std::lock_guard<std::mutex> lock(idMutex);
+    auto it = moduleIds.find(moduleName);
+    return it != moduleIds.end() ? it->second : kInvalidModuleId;
+}
+
+LatencyHistogram* HealthMonitor::latencyHistogram(ModuleId moduleId, LatencyOperation operation) const {
+    if (moduleId >= moduleIdCount.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    return &moduleLatency[moduleId]->histograms[static_cast<size_t>(operation)];
+}
+
+// Each thread leases one counter block for its lifetime, so recording never
+// touches a lock or a shared cache line. Blocks of exited threads are handed
+// to new threads with their counts intact.
+HealthMonitor::CounterBlock& HealthMonitor::localCounterBlock() {
+    struct Lease {
+        CounterBlock* block = nullptr;
+        ~Lease() {
+            if (block) {
+                block->inUse.store(false, std::memory_order_release);
+            }
+        }
+    };
+    thread_local Lease lease;
+    if (lease.block) {
+        return *lease.block;
+    }
+
+    std::lock_guard<std::mutex> lock(blockMutex);
+    for (auto& block : counterBlocks) {
+        bool expected = false;
+        if (block->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            lease.block = block.get();
+            return *lease.block;
+        }
+    }
+    counterBlocks.push_back(std::make_unique<CounterBlock>()); // value-initialized: all zero
+    counterBlocks.back()->inUse.store(true, std::memory_order_relaxed);
+    lease.block = counterBlocks.back().get();
+    return *lease.block;
+}
+
+uint64_t HealthMonitor::sumCounter(ModuleId moduleId, CounterKind kind) const {
+    std::lock_guard<std::mutex> lock(blockMutex);
+    uint64_t total = 0;
+    for (const auto& block : counterBlocks) {
+        total += block->counters[moduleId][kind].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
 void HealthMonitor::recordModuleLoad(const std::string& moduleName, 
-                                    std::chrono::milliseconds loadTime) {
-    std::lock_guard<std::mutex> lock(healthMutex);
-    
-    auto& metrics = moduleMetrics[moduleName];
-    metrics.totalLoads++;
-    metrics.lastOperationTime = std::chrono::steady_clock::now();
-    
-    // Update average load time
-    if (metrics.totalLoads == 1) {
-        metrics.averageLoadTime = loadTime;
-    } else {
-        metrics.averageLoadTime = std::chrono::milliseconds(
-            (metrics.averageLoadTime.count() * (metrics.totalLoads - 1) + loadTime.count()) / metrics.totalLoads
-        );
+                                    std::chrono::nanoseconds loadTime) {
+    recordModuleLoad(getModuleId(moduleName), loadTime);
+}
+
+void HealthMonitor::recordModuleUnload(const std::string& moduleName,
+                                      std::chrono::nanoseconds unloadTime) {
+    recordModuleUnload(getModuleId(moduleName), unloadTime);
+}
+
+void HealthMonitor::recordHotSwap(const std::string& moduleName, bool success,
+                                 std::chrono::nanoseconds swapTime) {
+    recordHotSwap(getModuleId(moduleName), success, swapTime);
+}
+
+void HealthMonitor::recordModuleLoad(ModuleId moduleId, std::chrono::nanoseconds loadTime) {
+    auto* histogram = latencyHistogram(moduleId, LatencyOperation::LOAD);
+    if (!histogram) {
+        return;
     }
+    localCounterBlock().counters[moduleId][LOADS].fetch_add(1, std::memory_order_relaxed);
+    lastOperationNs[moduleId].store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                                    std::memory_order_relaxed);
+    histogram->record(static_cast<uint64_t>(loadTime.count()));
+}
 
-    auto& logger = Logger::getInstance();
-    logger.debug("Recorded module load: " + moduleName + 
-                " (time: " + std::to_string(loadTime.count()) + "ms)", "HealthMonitor");
+void HealthMonitor::recordModuleUnload(ModuleId moduleId, std::chrono::nanoseconds unloadTime) {
+    auto* histogram = latencyHistogram(moduleId, LatencyOperation::UNLOAD);
+    if (!histogram) {
+        return;
+    }
+    localCounterBlock().counters[moduleId][UNLOADS].fetch_add(1, std::memory_order_relaxed);
+    lastOperationNs[moduleId].store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                                    std::memory_order_relaxed);
+    if (unloadTime.count() > 0) {
+        histogram->record(static_cast<uint64_t>(unloadTime.count()));
+    }
 }
 
-void HealthMonitor::recordModuleUnload(const std::string& moduleName) {
-    std::lock_guard<std::mutex> lock(healthMutex);
-    
-    auto& metrics = moduleMetrics[moduleName];
-    metrics.totalUnloads++;
-    metrics.lastOperationTime = std::chrono::steady_clock::now();
+void HealthMonitor::recordHotSwap(ModuleId moduleId, bool success, std::chrono::nanoseconds swapTime) {
+    auto* histogram = latencyHistogram(moduleId, LatencyOperation::HOT_SWAP);
+    if (!histogram) {
+        return;
+    }
+    auto& counters = localCounterBlock().counters[moduleId];
+    counters[HOT_SWAPS].fetch_add(1, std::memory_order_relaxed);
+    if (!success) {
+        counters[FAILED_OPERATIONS].fetch_add(1, std::memory_order_relaxed);
+    }
+    lastOperationNs[moduleId].store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                                    std::memory_order_relaxed);
+    if (swapTime.count() > 0) {
+        histogram->record(static_cast<uint64_t>(swapTime.count()));
+    }
+}
+
+// O(1): a few floating-point operations under the module's spin flag
+bool HealthMonitor::updateBaseline(ModuleId moduleId, BaselineKind kind, std::chrono::nanoseconds latency) {
+    if (moduleId >= moduleIdCount.load(std::memory_order_acquire)) {
+        return false;
+    }
+    auto policy = std::atomic_load(&degradationPolicy);
+    if (!policy->enabled) {
+        return false;
+    }
+
+    ModuleBaselines& baselines = moduleBaselines[moduleId];
+    while (baselines.busy.test_and_set(std::memory_order_acquire)) {
+    }
+    (void)kind; // health checks are the only kind so far
+    bool drifting = baselines.check.update(static_cast<double>(latency.count()), *policy);
+    baselines.busy.clear(std::memory_order_release);
+    return drifting;
+}
+
+void HealthMonitor::resetLatencyBaseline(const std::string& moduleName) {
+    resetLatencyBaseline(findModuleId(moduleName));
+}
+
+void HealthMonitor::resetLatencyBaseline(ModuleId moduleId) {
+    if (moduleId >= moduleIdCount.load(std::memory_order_acquire)) {
+        return;
+    }
+    ModuleBaselines& baselines = moduleBaselines[moduleId];
+    while (baselines.busy.test_and_set(std::memory_order_acquire)) {
+    }
+    baselines.check = LatencyBaseline{};
+    baselines.busy.clear(std::memory_order_release);
+}
+
+bool HealthMonitor::isLatencyDegraded(ModuleId moduleId) const {
+    if (moduleId >= moduleIdCount.load(std::memory_order_acquire) ||
+        !std::atomic_load(&degradationPolicy)->enabled) {
+        return false;
+    }
+    ModuleBaselines& baselines = moduleBaselines[moduleId];
+    while (baselines.busy.test_and_set(std::memory_order_acquire)) {
+    }
+    bool degraded = baselines.check.drifting;
+    baselines.busy.clear(std::memory_order_release);
+    return degraded;
+}
+
+LatencyBaseline HealthMonitor::getLatencyBaseline(const std::string& moduleName, BaselineKind kind) const {
+    ModuleId moduleId = findModuleId(moduleName);
+    if (moduleId == kInvalidModuleId) {
+        return LatencyBaseline{};
+    }
+    ModuleBaselines& baselines = moduleBaselines[moduleId];
+    while (baselines.busy.test_and_set(std::memory_order_acquire)) {
+    }
+    (void)kind;
+    LatencyBaseline copy = baselines.check;
+    baselines.busy.clear(std::memory_order_release);
+    return copy;
+}
+
+LatencySnapshot HealthMonitor::getLatencySnapshot(const std::string& moduleName,
+                                                  LatencyOperation operation, bool resetInterval) {
+    auto* histogram = latencyHistogram(findModuleId(moduleName), operation);
+    if (!histogram) {
+        return LatencySnapshot{};
+    }
+    return resetInterval ? histogram->snapshotAndReset() : histogram->snapshot();
+}
+
+LatencySnapshot HealthMonitor::getSystemLatencySnapshot(LatencyOperation operation) const {
+    LatencySnapshot merged;
+    uint32_t count = moduleIdCount.load(std::memory_order_acquire);
+    for (ModuleId id = 0; id < count; id++) {
+        merged.merge(moduleLatency[id]->histograms[static_cast<size_t>(operation)].snapshot());
+    }
+    return merged;
+}
+
+HealthMonitor::ModuleMetrics HealthMonitor::getModuleMetrics(const std::string& moduleName) const {
+    ModuleMetrics metrics{};
+    ModuleId id = findModuleId(moduleName);
+    if (id == kInvalidModuleId) {
+        return metrics;
+    }
+
+    metrics.totalLoads = sumCounter(id, LOADS);
+    metrics.totalUnloads = sumCounter(id, UNLOADS);
+    metrics.totalHotSwaps = sumCounter(id, HOT_SWAPS);
+    metrics.failedOperations = sumCounter(id, FAILED_OPERATIONS);
+    metrics.lastOperationTime = std::chrono::steady_clock::time_point(
+        std::chrono::steady_clock::duration(lastOperationNs[id].load(std::memory_order_relaxed)));
+
+    // Mean load time falls out of the load histogram's running sum
+    auto loads = moduleLatency[id]->histograms[static_cast<size_t>(LatencyOperation::LOAD)].snapshot();
+    metrics.averageLoadTime = std::chrono::nanoseconds(static_cast<int64_t>(loads.meanNs()));
+    return metrics;
+}
+
+std::shared_ptr<const HealthMonitor::MetricsSnapshot> HealthMonitor::getMetricsSnapshot() const {
+    return std::atomic_load(&latestMetrics);
+}
+
+void HealthMonitor::publishMetricsSnapshot() {
+    std::lock_guard<std::mutex> publishLock(publishMutex);
+
+    auto snapshot = std::make_shared<MetricsSnapshot>();
+    snapshot->generatedAt = std::chrono::system_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(idMutex);
+        snapshot->modules.resize(moduleNames.size());
+        for (size_t id = 0; id < moduleNames.size(); id++) {
+            snapshot->modules[id].name = moduleNames[id];
+        }
+    }
+
+    // Counters and histograms are read lock-free, outside healthMutex
+    for (ModuleId id = 0; id < snapshot->modules.size(); id++) {
+        ModuleSample& sample = snapshot->modules[id];
+        sample.registered = false;
+        sample.status = HealthStatus::UNHEALTHY;
+        sample.consecutiveFailures = 0;
+        sample.responseTimeMs = 0;
+        sample.totalLoads = sumCounter(id, LOADS);
+        sample.totalUnloads = sumCounter(id, UNLOADS);
+        sample.totalHotSwaps = sumCounter(id, HOT_SWAPS);
+        sample.failedOperations = sumCounter(id, FAILED_OPERATIONS);
+        for (size_t op = 0; op < kLatencyOperationCount; op++) {
+            sample.latency[op] = LatencySummary::from(moduleLatency[id]->histograms[op].snapshot());
+        }
+        sample.memory.heapBytes = ModuleCallScope::heapBytes(id);
+        sample.cpuTimeNs = ModuleCallScope::cpuTimeNs(id);
+        sample.timedCalls = ModuleCallScope::callCount(id);
+    }
 
+    // Image memory of loaded modules; taken before healthMutex (ModuleManager
+    // calls into the monitor while holding its own lock)
+    for (const auto& [id, memory] : ModuleManager::getInstance().sampleModuleMemory()) {
+        if (id < snapshot->modules.size()) {
+            snapshot->modules[id].memory = memory;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(healthMutex);
+        snapshot->systemHealth = systemHealth.load(std::memory_order_relaxed);
+        for (ModuleSample& sample : snapshot->modules) {
+            auto it = healthStatus.find(sample.name);
+            if (it == healthStatus.end()) {
+                continue;
+            }
+            sample.registered = true;
+            sample.status = it->second.status;
+            sample.consecutiveFailures = it->second.consecutiveFailures;
+            sample.responseTimeMs = it->second.responseTimeMs;
+        }
+    }
+
+    if (metricsSegment) {
+        writeMetricsSegment(*snapshot);
+    }
+    std::atomic_store(&latestMetrics, std::shared_ptr<const MetricsSnapshot>(std::move(snapshot)));
+}
+
+bool HealthMonitor::enableSharedMemoryMetrics(const std::string& segmentName) {
     auto& logger = Logger::getInstance();
-    logger.debug("Recorded module unload: " + moduleName, "HealthMonitor");
+    {
+        std::lock_guard<std::mutex> publishLock(publishMutex);
+        if (metricsSegment) {
+            logger.warning("Shared-memory metrics already enabled: " + metricsSegmentName, "HealthMonitor");
+            return false;
+        }
+
+        std::string name = segmentName.empty() ? metrics_segment::defaultName(getpid()) : segmentName;
+        int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            logger.error("shm_open failed for " + name + ": " + std::string(strerror(errno)), "HealthMonitor");
+            return false;
+        }
+        void* mapping = MAP_FAILED;
+        if (ftruncate(fd, sizeof(metrics_segment::Segment)) == 0) {
+            mapping = mmap(nullptr, sizeof(metrics_segment::Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            logger.error("Failed to map metrics segment " + name + ": " + std::string(strerror(errno)),
+                         "HealthMonitor");
+            shm_unlink(name.c_str());
+            return false;
+        }
+
+        // Start from a clean layout even if a stale segment had the same name
+        auto* segment = static_cast<metrics_segment::Segment*>(mapping);
+        memset(static_cast<void*>(segment), 0, sizeof(metrics_segment::Segment));
+        auto& header = segment->header;
+        header.version = metrics_segment::kVersion;
+        header.headerSize = sizeof(metrics_segment::Header);
+        header.recordSize = sizeof(metrics_segment::ModuleRecord);
+        header.capacity = metrics_segment::kMaxModules;
+        header.hostPid = getpid();
+        header.magic.store(metrics_segment::kMagic, std::memory_order_release);
+
+        metricsSegment = segment;
+        metricsSegmentName = name;
+        logger.info("Shared-memory metrics published at " + name, "HealthMonitor");
+    }
+
+    publishMetricsSnapshot();
+    return true;
 }
 
-void HealthMonitor::recordHotSwap(const std::string& moduleName, bool success) {
-    std::lock_guard<std::mutex> lock(healthMutex);
-    
-    auto& metrics = moduleMetrics[moduleName];
-    metrics.totalHotSwaps++;
-    metrics.lastOperationTime = std::chrono::steady_clock::now();
-    
-    if (!success) {
-        metrics.failedOperations++;
+void HealthMonitor::disableSharedMemoryMetrics() {
+    std::lock_guard<std::mutex> publishLock(publishMutex);
+    if (!metricsSegment) {
+        return;
+    }
+
+    munmap(metricsSegment, sizeof(metrics_segment::Segment));
+    shm_unlink(metricsSegmentName.c_str());
+    Logger::getInstance().info("Shared-memory metrics removed: " + metricsSegmentName, "HealthMonitor");
+    metricsSegment = nullptr;
+    metricsSegmentName.clear();
+}
+
+std::string HealthMonitor::getSharedMemoryMetricsName() const {
+    std::lock_guard<std::mutex> publishLock(publishMutex);
+    return metricsSegmentName;
+}
+
+// Caller must hold publishMutex. Snapshot modules are ordered by ID, which
+// is also the record index, so names only ever need writing once.
+void HealthMonitor::writeMetricsSegment(const MetricsSnapshot& snapshot) {
+    auto& header = metricsSegment->header;
+    size_t count = std::min(snapshot.modules.size(), metrics_segment::kMaxModules);
+    size_t published = header.moduleCount.load(std::memory_order_relaxed);
+
+    for (size_t id = 0; id < count; id++) {
+        const ModuleSample& sample = snapshot.modules[id];
+        auto& record = metricsSegment->modules[id];
+        if (id >= published) {
+            strncpy(record.name, sample.name.c_str(), metrics_segment::kNameLength - 1);
+        }
+
+        metrics_segment::beginWrite(record);
+        record.registered.store(sample.registered ? 1 : 0, std::memory_order_relaxed);
+        record.status.store(static_cast<uint32_t>(sample.status), std::memory_order_relaxed);
+        record.consecutiveFailures.store(static_cast<uint32_t>(sample.consecutiveFailures),
+                                         std::memory_order_relaxed);
+        record.responseTimeNs.store(static_cast<uint64_t>(sample.responseTimeMs * 1e6), std::memory_order_relaxed);
+        record.totalLoads.store(sample.totalLoads, std::memory_order_relaxed);
+        record.totalUnloads.store(sample.totalUnloads, std::memory_order_relaxed);
+        record.totalHotSwaps.store(sample.totalHotSwaps, std::memory_order_relaxed);
+        record.failedOperations.store(sample.failedOperations, std::memory_order_relaxed);
+        record.mappedBytes.store(sample.memory.mappedBytes, std::memory_order_relaxed);
+        record.residentBytes.store(sample.memory.residentBytes, std::memory_order_relaxed);
+        record.heapBytes.store(sample.memory.heapBytes, std::memory_order_relaxed);
+        record.cpuTimeNs.store(sample.cpuTimeNs, std::memory_order_relaxed);
+        record.timedCalls.store(sample.timedCalls, std::memory_order_relaxed);
+        for (size_t op = 0; op < kLatencyOperationCount; op++) {
+            const LatencySummary& summary = sample.latency[op];
+            auto& latency = record.latency[op];
+            latency.count.store(summary.count, std::memory_order_relaxed);
+            latency.sumNs.store(summary.sumNs, std::memory_order_relaxed);
+            latency.p50Ns.store(summary.p50Ns, std::memory_order_relaxed);
+            latency.p99Ns.store(summary.p99Ns, std::memory_order_relaxed);
+            latency.p999Ns.store(summary.p999Ns, std::memory_order_relaxed);
+            latency.maxNs.store(summary.maxNs, std::memory_order_relaxed);
+        }
+        metrics_segment::endWrite(record);
+    }
+
+    if (count > published) {
+        header.moduleCount.store(static_cast<uint32_t>(count), std::memory_order_release);
+    }
+    header.systemHealth.store(static_cast<uint32_t>(snapshot.systemHealth), std::memory_order_relaxed);
+    header.publishedAtNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   snapshot.generatedAt.time_since_epoch()).count(),
+                               std::memory_order_relaxed);
+    header.publishCount.fetch_add(1, std::memory_order_release);
+}
+
+void HealthMonitor::setRemediationHandler(RemediationHandler handler) {
+    bool enabled;
+    {
+        std::lock_guard<std::mutex> lock(healthMutex);
+        remediationHandler = std::move(handler);
+        enabled = static_cast<bool>(remediationHandler);
     }
+    wakeMonitor();
 
     auto& logger = Logger::getInstance();
-    logger.debug("Recorded hot-swap: " + moduleName + " (success: " + 
-                (success ? "yes" : "no") + ")", "HealthMonitor");
+    logger.info(std::string("Automatic remediation ") + (enabled ? "enabled" : "disabled"), "HealthMonitor");
 }
 
-HealthMonitor::ModuleMetrics HealthMonitor::getModuleMetrics(const std::string& moduleName) const {
+void HealthMonitor::setRemediationPolicy(const RemediationPolicy& policy) {
     std::lock_guard<std::mutex> lock(healthMutex);
-    
-    auto it = moduleMetrics.find(moduleName);
-    if (it != moduleMetrics.end()) {
-        return it->second;
+    remediationPolicy = policy;
+    if (remediationPolicy.escalation.empty()) {
+        remediationPolicy.escalation.push_back(RemediationAction::RELOAD_LIBRARY);
     }
-    
-    return ModuleMetrics{};
+    remediationPolicy.budget = std::max(1, remediationPolicy.budget);
+    remediationPolicy.backoffMultiplier = std::max(1.0, remediationPolicy.backoffMultiplier);
 }
 
-void HealthMonitor::updateSystemHealth() {
+HealthMonitor::RemediationStatus HealthMonitor::getRemediationStatus(const std::string& moduleName) const {
     std::lock_guard<std::mutex> lock(healthMutex);
-    
-    int criticalCount = 0;
-    int unhealthyCount = 0;
-    int healthyCount = 0;
 
-    for (const auto& [moduleName, health] : healthStatus) {
-        switch (health.status) {
-            case HealthStatus::CRITICAL:
-                criticalCount++;
-                break;
-            case HealthStatus::UNHEALTHY:
-                unhealthyCount++;
-                break;
-            case HealthStatus::DEGRADED:
-                unhealthyCount++;
-                break;
-            case HealthStatus::HEALTHY:
-                healthyCount++;
-                break;
+    RemediationStatus status{};
+    auto it = remediationStates.find(moduleName);
+    if (it != remediationStates.end()) {
+        status.attempts = it->second.attempts;
+        status.circuitOpen = it->second.circuitOpen;
+        status.inFlight = it->second.inFlight;
+        status.hasLastAction = it->second.hasLastAction;
+        status.lastAction = it->second.lastAction;
+        status.lastSucceeded = it->second.lastSucceeded;
+    }
+    return status;
+}
+
+static const char* remediationActionName(HealthMonitor::RemediationAction action) {
+    switch (action) {
+        case HealthMonitor::RemediationAction::RESTART_INSTANCE: return "restart";
+        case HealthMonitor::RemediationAction::RELOAD_LIBRARY: return "reload";
+        case HealthMonitor::RemediationAction::ROLLBACK: return "rollback";
+    }
+    return "unknown";
+}
+
+// Monitor thread: decide which CRITICAL modules get an attempt now. Attempts
+// run one at a time on remediationPool, outside healthMutex, because the
+// handler re-registers the module through ModuleManager.
+void HealthMonitor::planRemediation(std::chrono::steady_clock::time_point now) {
+    auto& logger = Logger::getInstance();
+    std::vector<std::pair<std::string, RemediationAction>> attempts;
+    RemediationHandler handler;
+    nextRemediationDue = std::chrono::steady_clock::time_point::max();
+    {
+        std::lock_guard<std::mutex> lock(healthMutex);
+        if (!remediationHandler || !remediationPool) {
+            return;
+        }
+        handler = remediationHandler;
+        const RemediationPolicy& policy = remediationPolicy;
+
+        for (const auto& [moduleName, health] : healthStatus) {
+            if (health.status != HealthStatus::CRITICAL) {
+                auto stateIt = remediationStates.find(moduleName);
+                if (stateIt == remediationStates.end()) {
+                    continue;
+                }
+                RemediationState& state = stateIt->second;
+                if (health.status != HealthStatus::HEALTHY) {
+                    state.healthySince = {};
+                    continue;
+                }
+                if (state.healthySince == std::chrono::steady_clock::time_point{}) {
+                    state.healthySince = now;
+                }
+                if ((state.attempts > 0 || state.halfOpen || state.circuitOpen) &&
+                    now - state.healthySince >= policy.stableTime) {
+                    logger.info("Module stable again, remediation reset: " + moduleName, "HealthMonitor");
+                    state.attempts = 0;
+                    state.circuitOpen = false;
+                    state.halfOpen = false;
+                    state.halfOpenAttempted = false;
+                }
+                continue;
+            }
+
+            RemediationState& state = remediationStates[moduleName];
+            state.healthySince = {};
+            if (state.inFlight) {
+                continue;
+            }
+
+            if (state.circuitOpen) {
+                if (now < state.circuitOpenUntil) {
+                    nextRemediationDue = std::min(nextRemediationDue, state.circuitOpenUntil);
+                    continue;
+                }
+                state.circuitOpen = false;
+                state.halfOpen = true;
+                state.halfOpenAttempted = false;
+                state.window.clear();
+                logger.info("Remediation circuit half-open, allowing one trial: " + moduleName, "HealthMonitor");
+            }
+
+            if (state.halfOpen && state.halfOpenAttempted) {
+                state.circuitOpen = true;
+                state.circuitOpenUntil = now + policy.circuitOpenTime;
+                nextRemediationDue = std::min(nextRemediationDue, state.circuitOpenUntil);
+                logger.error("Remediation trial failed, circuit re-opened for " +
+                             std::to_string(policy.circuitOpenTime.count()) + "ms: " + moduleName, "HealthMonitor");
+                continue;
+            }
+
+            if (now < state.nextAttempt) {
+                nextRemediationDue = std::min(nextRemediationDue, state.nextAttempt);
+                continue;
+            }
+
+            while (!state.window.empty() && now - state.window.front() >= policy.budgetWindow) {
+                state.window.pop_front();
+            }
+            if (static_cast<int>(state.window.size()) >= policy.budget) {
+                state.circuitOpen = true;
+                state.circuitOpenUntil = now + policy.circuitOpenTime;
+                nextRemediationDue = std::min(nextRemediationDue, state.circuitOpenUntil);
+                logger.error("Remediation budget exhausted (" + std::to_string(policy.budget) + " per " +
+                             std::to_string(policy.budgetWindow.count()) + "ms), circuit open for " +
+                             std::to_string(policy.circuitOpenTime.count()) + "ms: " + moduleName, "HealthMonitor");
+                continue;
+            }
+
+            size_t step = std::min(static_cast<size_t>(state.attempts), policy.escalation.size() - 1);
+            RemediationAction action = policy.escalation[step];
+            double backoff = policy.initialBackoff.count() * std::pow(policy.backoffMultiplier, state.attempts);
+            backoff = std::min(backoff, static_cast<double>(policy.maxBackoff.count()));
+
+            state.attempts++;
+            state.window.push_back(now);
+            state.backoff = std::chrono::milliseconds(static_cast<int64_t>(backoff));
+            state.nextAttempt = now + state.backoff;
+            state.halfOpenAttempted = state.halfOpen;
+            state.inFlight = true;
+            attempts.emplace_back(moduleName, action);
+        }
+    }
+
+    for (auto& [moduleName, action] : attempts) {
+        logger.warning("Remediating CRITICAL module " + moduleName + ": " + remediationActionName(action),
+                       "HealthMonitor");
+        remediationPool->submit([this, moduleName, action, handler]() {
+            runRemediation(moduleName, action, handler);
+        });
+    }
+}
+
+void HealthMonitor::runRemediation(const std::string& moduleName, RemediationAction action,
+                                   const RemediationHandler& handler) {
+    auto& logger = Logger::getInstance();
+
+    bool succeeded = false;
+    try {
+        succeeded = handler(moduleName, action);
+    } catch (const std::exception& e) {
+        logger.error("Remediation handler exception for " + moduleName + ": " + e.what(), "HealthMonitor");
+    } catch (...) {
+        logger.error("Remediation handler unknown exception for " + moduleName, "HealthMonitor");
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(healthMutex);
+        auto& state = remediationStates[moduleName];
+        state.inFlight = false;
+        state.nextAttempt = std::chrono::steady_clock::now() + state.backoff;
+        state.hasLastAction = true;
+        state.lastAction = action;
+        state.lastSucceeded = succeeded;
+
+        // Confirm the fix right away instead of waiting out the interval
+        if (succeeded) {
+            std::lock_guard<std::mutex> scheduleLock(schedulerMutex);
+            scheduleImmediateCheck(moduleName);
+        }
+    }
+
+    if (succeeded) {
+        logger.info(std::string("Remediation ") + remediationActionName(action) + " succeeded: " + moduleName,
+                    "HealthMonitor");
+    } else {
+        logger.error(std::string("Remediation ") + remediationActionName(action) + " failed: " + moduleName,
+                     "HealthMonitor");
+    }
+    wakeMonitor();
+}
+
+// Caller must hold healthMutex; the only writer of healthStatus entries
+void HealthMonitor::storeModuleStatus(const std::string& moduleName, const HealthCheckResult& result) {
+    auto [it, inserted] = healthStatus.try_emplace(moduleName, result);
+    if (!inserted) {
+        // Registration placeholders are not results, everything after is
+        HealthSample sample{};
+        sample.timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        sample.responseTimeMs = static_cast<float>(result.responseTimeMs);
+        sample.consecutiveFailures = static_cast<uint16_t>(std::min(result.consecutiveFailures, 65535));
+        sample.status = static_cast<uint8_t>(result.status);
+        healthHistory.record(moduleName, sample);
+
+        if (it->second.status == result.status) {
+            it->second = result;
+            return;
         }
+        statusCounts[static_cast<size_t>(it->second.status)].fetch_sub(1, std::memory_order_relaxed);
+        it->second = result;
     }
+    statusCounts[static_cast<size_t>(result.status)].fetch_add(1, std::memory_order_relaxed);
+
+    if (result.status == HealthStatus::CRITICAL) {
+        criticalModules.insert(moduleName);
+    } else {
+        criticalModules.erase(moduleName);
+    }
+    updateSystemHealth();
+}
+
+// Caller must hold healthMutex
+void HealthMonitor::eraseModuleStatus(const std::string& moduleName) {
+    auto it = healthStatus.find(moduleName);
+    if (it == healthStatus.end()) {
+        return;
+    }
+    statusCounts[static_cast<size_t>(it->second.status)].fetch_sub(1, std::memory_order_relaxed);
+    criticalModules.erase(moduleName);
+    healthStatus.erase(it);
+    updateSystemHealth();
+}
+
+// Caller must hold healthMutex. O(1) - derived from the per-status counts
+void HealthMonitor::updateSystemHealth() {
+    uint32_t criticalCount = statusCounts[static_cast<size_t>(HealthStatus::CRITICAL)].load(std::memory_order_relaxed);
+    uint32_t unhealthyCount = statusCounts[static_cast<size_t>(HealthStatus::UNHEALTHY)].load(std::memory_order_relaxed);
+    uint32_t degradedCount = statusCounts[static_cast<size_t>(HealthStatus::DEGRADED)].load(std::memory_order_relaxed);
+    uint32_t healthyCount = statusCounts[static_cast<size_t>(HealthStatus::HEALTHY)].load(std::memory_order_relaxed);
 
     HealthStatus newSystemHealth;
     if (criticalCount > 0) {
         newSystemHealth = HealthStatus::CRITICAL;
-    } else if (unhealthyCount > 0) {
+    } else if (unhealthyCount > 0 || degradedCount > 0) {
         newSystemHealth = HealthStatus::DEGRADED;
     } else if (healthyCount > 0) {
         newSystemHealth = HealthStatus::HEALTHY;
@@ -293,7 +1472,7 @@ void HealthMonitor::updateSystemHealth() {
     }
 
     // Log system health changes
-    if (newSystemHealth != systemHealth) {
+    if (newSystemHealth != systemHealth.load(std::memory_order_relaxed)) {
         auto& logger = Logger::getInstance();
         
         std::string healthMessage = "System health changed: ";
@@ -304,42 +1483,55 @@ void HealthMonitor::updateSystemHealth() {
             case HealthStatus::CRITICAL: healthMessage += "CRITICAL"; break;
         }
         healthMessage += " (healthy: " + std::to_string(healthyCount) +
-                        ", degraded: " + std::to_string(unhealthyCount) +
+                        ", degraded: " + std::to_string(degradedCount) +
+                        ", unhealthy: " + std::to_string(unhealthyCount) +
                         ", critical: " + std::to_string(criticalCount) + ")";
         
         logger.info(healthMessage, "HealthMonitor");
+
+        systemHealth.store(newSystemHealth, std::memory_order_release);
+        lastSystemCheck = std::chrono::steady_clock::now();
     }
+}
+
+HealthHistoryView HealthMonitor::getHealthHistory(const std::string& moduleName) const {
+    return healthHistory.get(moduleName);
+}
 
-    systemHealth = newSystemHealth;
-    lastSystemCheck = std::chrono::steady_clock::now();
+bool HealthMonitor::enableHealthHistoryFile(const std::string& path) {
+    return healthHistory.attachFile(path);
 }
 
 HealthMonitor::HealthStatus HealthMonitor::getSystemHealth() const {
-    return systemHealth;
+    return systemHealth.load(std::memory_order_acquire);
+}
+
+size_t HealthMonitor::getModuleCount(HealthStatus status) const {
+    return statusCounts[static_cast<size_t>(status)].load(std::memory_order_relaxed);
 }
 
+// Runs every system update, so both alerts are rate limited: however many
+// modules are critical, the log gets a bounded number of lines per cycle
 void HealthMonitor::checkForAlerts() {
     std::lock_guard<std::mutex> lock(healthMutex);
-    auto& logger = Logger::getInstance();
 
-    for (const auto& [moduleName, health] : healthStatus) {
-        if (health.status == HealthStatus::CRITICAL) {
-            logger.critical("CRITICAL ALERT: Module " + moduleName + " - " + health.message, "HealthMonitor");
-        }
+    for (const auto& moduleName : criticalModules) {
+        HOTSWAP_LOG_LIMITED(Logger::Level::CRITICAL, "HealthMonitor", 10, 50,
+                            "CRITICAL ALERT: Module " + moduleName + " - " + healthStatus[moduleName].message);
     }
 
-    if (systemHealth == HealthStatus::CRITICAL) {
-        logger.critical("SYSTEM CRITICAL ALERT: System health is CRITICAL", "HealthMonitor");
+    if (systemHealth.load(std::memory_order_relaxed) == HealthStatus::CRITICAL) {
+        HOTSWAP_LOG_LIMITED(Logger::Level::CRITICAL, "HealthMonitor", 1, 5,
+                            "SYSTEM CRITICAL ALERT: System health is CRITICAL");
     }
 }
 
+// An unchanged status line is only repeated once a minute
 void HealthMonitor::logHealthStatus() {
-    auto& logger = Logger::getInstance();
-    
     std::lock_guard<std::mutex> lock(healthMutex);
     
     std::string statusMessage = "Health Status - ";
-    switch (systemHealth) {
+    switch (systemHealth.load(std::memory_order_relaxed)) {
         case HealthStatus::HEALTHY: statusMessage += "HEALTHY"; break;
         case HealthStatus::DEGRADED: statusMessage += "DEGRADED"; break;
         case HealthStatus::UNHEALTHY: statusMessage += "UNHEALTHY"; break;
@@ -349,7 +1541,7 @@ void HealthMonitor::logHealthStatus() {
     statusMessage += " | Modules: " + std::to_string(healthStatus.size()) +
                     " | Monitoring: " + (monitoring ? "ACTIVE" : "INACTIVE");
     
-    logger.info(statusMessage, "HealthMonitor");
+    HOTSWAP_LOG_LIMITED(Logger::Level::INFO, "HealthMonitor", 1, 5, statusMessage);
 }
 
 void HealthMonitor::generateHealthReport() const {
@@ -361,13 +1553,19 @@ void HealthMonitor::generateHealthReport() const {
     
     // System health
     std::string systemHealthStr;
-    switch (systemHealth) {
+    switch (systemHealth.load(std::memory_order_relaxed)) {
         case HealthStatus::HEALTHY: systemHealthStr = "HEALTHY"; break;
         case HealthStatus::DEGRADED: systemHealthStr = "DEGRADED"; break;
         case HealthStatus::UNHEALTHY: systemHealthStr = "UNHEALTHY"; break;
         case HealthStatus::CRITICAL: systemHealthStr = "CRITICAL"; break;
     }
     logger.info("System Health: " + systemHealthStr, "HealthMonitor");
+
+    auto checkStats = getCheckStats();
+    logger.info("Check rate: " + std::to_string(checkStats.achievedChecksPerSecond) + "/s | Deferred: " +
+                std::to_string(checkStats.checksDeferred) + " | Check interval at detection p50/p99: " +
+                std::to_string(checkStats.checkIntervalAtDetection.p50() / 1000000) + "/" +
+                std::to_string(checkStats.checkIntervalAtDetection.p99() / 1000000) + "ms", "HealthMonitor");
     
     // Module health details
     for (const auto& [moduleName, health] : healthStatus) {
@@ -382,8 +1580,18 @@ void HealthMonitor::generateHealthReport() const {
         auto timeSinceCheck = std::chrono::duration_cast<std::chrono::seconds>(
             std::chrono::steady_clock::now() - health.lastCheck);
             
+        std::string latencySummary;
+        if (auto* histogram = latencyHistogram(findModuleId(moduleName), LatencyOperation::HEALTH_CHECK)) {
+            auto checks = histogram->snapshot();
+            if (checks.totalCount > 0) {
+                latencySummary = " | Check p50/p99/p999: " + std::to_string(checks.p50() / 1000) + "/" +
+                                 std::to_string(checks.p99() / 1000) + "/" +
+                                 std::to_string(checks.p999() / 1000) + "us";
+            }
+        }
+
         logger.info("Module: " + moduleName + " | Status: " + moduleStatus +
-                   " | Response: " + std::to_string(health.responseTimeMs) + "ms" +
+                   " | Response: " + std::to_string(health.responseTimeMs) + "ms" + latencySummary +
                    " | Failures: " + std::to_string(health.consecutiveFailures) +
                    " | Last check: " + std::to_string(timeSinceCheck.count()) + "s ago", 
                    "HealthMonitor");
@@ -392,11 +1600,130 @@ void HealthMonitor::generateHealthReport() const {
     logger.info("=== END HEALTH REPORT ===", "HealthMonitor");
 }
 
-void HealthMonitor::setCheckInterval(std::chrono::seconds interval) {
-    checkInterval = interval;
+void HealthMonitor::setCheckInterval(std::chrono::milliseconds interval) {
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex);
+        checkInterval = interval;
+        nextSystemUpdate = std::min(nextSystemUpdate, std::chrono::steady_clock::now() + interval);
+
+        // Modules on the default interval pick up the new one right away
+        for (auto& [moduleName, entry] : scheduledChecks) {
+            if (entry.timerId != 0 && entry.interval.count() == 0) {
+                scheduleCheck(moduleName, true);
+            }
+        }
+    }
+    wakeMonitor();
     
     auto& logger = Logger::getInstance();
-    logger.info("Health check interval set to: " + std::to_string(interval.count()) + "s", "HealthMonitor");
+    logger.info("Health check interval set to: " + std::to_string(interval.count()) + "ms", "HealthMonitor");
+}
+
+void HealthMonitor::setModuleCheckInterval(const std::string& moduleName,
+                                           std::chrono::milliseconds interval) {
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex);
+        auto& entry = scheduledChecks[moduleName]; // kept for a later registration too
+        entry.interval = interval;
+        if (entry.timerId != 0) {
+            scheduleCheck(moduleName, false);
+        }
+    }
+    wakeMonitor();
+
+    auto& logger = Logger::getInstance();
+    logger.info("Health check interval for " + moduleName + " set to: " +
+                std::to_string(interval.count()) + "ms", "HealthMonitor");
+}
+
+void HealthMonitor::setCheckJitter(double fraction) {
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+    checkJitter = std::min(std::max(fraction, 0.0), 0.5);
+}
+
+void HealthMonitor::setCheckTimeout(std::chrono::milliseconds timeout) {
+    checkTimeoutNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count(),
+                         std::memory_order_relaxed);
+
+    auto& logger = Logger::getInstance();
+    logger.info("Health check timeout set to: " + std::to_string(timeout.count()) + "ms", "HealthMonitor");
+}
+
+void HealthMonitor::setCheckWorkers(size_t workers) {
+    checkWorkers = std::max<size_t>(workers, 1);
+}
+
+void HealthMonitor::setHeartbeatTimeout(std::chrono::milliseconds timeout) {
+    heartbeatTimeoutNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count(),
+                             std::memory_order_relaxed);
+
+    auto& logger = Logger::getInstance();
+    logger.info("Heartbeat timeout set to: " + std::to_string(timeout.count()) + "ms", "HealthMonitor");
+}
+
+void HealthMonitor::setMetricsPublishInterval(std::chrono::milliseconds interval) {
+    if (interval.count() <= 0) {
+        interval = std::chrono::milliseconds(1);
+    }
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex);
+        metricsPublishInterval = interval;
+        nextMetricsPublish = std::min(nextMetricsPublish, std::chrono::steady_clock::now() + interval);
+    }
+    wakeMonitor();
+
+    auto& logger = Logger::getInstance();
+    logger.info("Metrics publish interval set to: " + std::to_string(interval.count()) + "ms", "HealthMonitor");
+}
+
+void HealthMonitor::setAdaptiveCheckPolicy(const AdaptiveCheckPolicy& policy) {
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex);
+        adaptivePolicy = policy;
+        adaptivePolicy.stableChecks = std::max(1u, adaptivePolicy.stableChecks);
+        adaptivePolicy.growth = std::max(1.0, adaptivePolicy.growth);
+        adaptivePolicy.minFactor = std::min(std::max(0.01, adaptivePolicy.minFactor), 1.0);
+        adaptivePolicy.maxFactor = std::max(1.0, adaptivePolicy.maxFactor);
+        for (auto& [moduleName, entry] : scheduledChecks) {
+            entry.stretch = std::min(std::max(entry.stretch, adaptivePolicy.minFactor), adaptivePolicy.maxFactor);
+            entry.healthyStreak = 0;
+        }
+    }
+
+    auto& logger = Logger::getInstance();
+    logger.info(std::string("Adaptive check intervals ") + (policy.enabled ? "enabled" : "disabled"),
+                "HealthMonitor");
+}
+
+void HealthMonitor::setDegradationPolicy(const LatencyBaseline::Policy& policy) {
+    auto sanitized = std::make_shared<LatencyBaseline::Policy>(policy);
+    sanitized->fastAlpha = std::min(std::max(sanitized->fastAlpha, 0.001), 1.0);
+    sanitized->baselineAlpha = std::min(std::max(sanitized->baselineAlpha, 0.0001), 1.0);
+    sanitized->ratioThreshold = std::max(1.0, sanitized->ratioThreshold);
+    std::atomic_store(&degradationPolicy, std::shared_ptr<const LatencyBaseline::Policy>(std::move(sanitized)));
+
+    auto& logger = Logger::getInstance();
+    logger.info(std::string("Latency degradation detection ") + (policy.enabled ? "enabled" : "disabled"),
+                "HealthMonitor");
+}
+
+void HealthMonitor::setCheckBudget(double checksPerSecond) {
+    checkBudget.store(std::max(0.0, checksPerSecond), std::memory_order_relaxed);
+    wakeMonitor();
+
+    auto& logger = Logger::getInstance();
+    logger.info(checksPerSecond > 0 ? "Health check budget set to: " + std::to_string(checksPerSecond) + "/s"
+                                    : std::string("Health check budget disabled"), "HealthMonitor");
+}
+
+HealthMonitor::CheckStats HealthMonitor::getCheckStats() const {
+    CheckStats stats;
+    stats.checksStarted = checksStarted.load(std::memory_order_relaxed);
+    stats.checksDeferred = checksDeferred.load(std::memory_order_relaxed);
+    stats.achievedChecksPerSecond = achievedCheckRate.load(std::memory_order_relaxed);
+    stats.detections = detections.load(std::memory_order_relaxed);
+    stats.checkIntervalAtDetection = checkIntervalAtDetection.snapshot();
+    return stats;
 }
 
 void HealthMonitor::setFailureThreshold(int threshold) {
@@ -3,12 +3,26 @@
 #include <thread>
 #include <chrono>
 #include <unordered_map>
+#include <unordered_set>
 #include <functional>
 #include <string>
 #include <mutex>
+#include <memory>
+#include <vector>
+#include <condition_variable>
+#include <random>
+#include <deque>
+#include "Heartbeat.hpp"
+#include "TimerWheel.hpp"
+#include "WorkerPool.hpp"
+#include "LatencyHistogram.hpp"
+#include "LatencyBaseline.hpp"
+#include "HealthHistory.hpp"
+#include "ModuleInfo.hpp"
 #include "../utils/Logger.hpp"
 
 class ModuleManager; // Forward declaration
+namespace metrics_segment { struct Segment; }
 
 class HealthMonitor {
 public:
@@ -36,10 +50,110 @@ public:
         size_t totalHotSwaps;
         size_t failedOperations;
         std::chrono::milliseconds totalUptime;
-        std::chrono::milliseconds averageLoadTime;
+        std::chrono::nanoseconds averageLoadTime; // loads are often well under a millisecond
         std::chrono::steady_clock::time_point lastOperationTime;
     };
 
+    // Operations with a latency histogram per module
+    enum class LatencyOperation {
+        LOAD,
+        UNLOAD,
+        HOT_SWAP,
+        HEALTH_CHECK
+    };
+    static constexpr size_t kLatencyOperationCount = 4;
+
+    // Capacity of the contiguous heartbeat slot array
+    static constexpr size_t kMaxHeartbeatSlots = 4096;
+
+    // Adaptive check intervals for modules on the default interval: stable
+    // modules are stretched out, failing or freshly (re)loaded ones tightened
+    struct AdaptiveCheckPolicy {
+        bool enabled = true;
+        uint32_t stableChecks = 5;  // healthy results in a row before each stretch
+        double growth = 1.5;        // interval multiplier per stretch
+        double maxFactor = 8.0;     // longest: checkInterval * maxFactor
+        double minFactor = 0.25;    // after a failure or (re)registration
+    };
+    struct CheckStats {
+        uint64_t checksStarted;
+        uint64_t checksDeferred;          // pushed back by the checks/sec budget
+        double achievedChecksPerSecond;   // over roughly the last second
+        uint64_t detections;              // passing -> failing transitions seen by polling
+        LatencySnapshot checkIntervalAtDetection; // last passing check -> first failing one; bounds
+                                                  // detection time, not time since the fault
+    };
+
+    // Latencies with a learned baseline; drifting beyond it marks a module DEGRADED
+    enum class BaselineKind {
+        HEALTH_CHECK
+    };
+
+    // Automatic remediation of CRITICAL modules
+    enum class RemediationAction {
+        RESTART_INSTANCE,  // stop/cleanup/init/start the same instance
+        RELOAD_LIBRARY,    // hot-swap the module from its library
+        ROLLBACK           // hot-swap back to the previous library version
+    };
+    struct RemediationPolicy {
+        // Attempt n uses escalation[min(n, size - 1)]
+        std::vector<RemediationAction> escalation{RemediationAction::RESTART_INSTANCE,
+                                                  RemediationAction::RELOAD_LIBRARY,
+                                                  RemediationAction::ROLLBACK};
+        // Delay before attempt n+1 is initialBackoff * multiplier^(n-1), capped
+        std::chrono::milliseconds initialBackoff{std::chrono::seconds(1)};
+        std::chrono::milliseconds maxBackoff{std::chrono::minutes(1)};
+        double backoffMultiplier = 2.0;
+        // Restart budget; exhausting it opens the circuit breaker
+        int budget = 5;
+        std::chrono::milliseconds budgetWindow{std::chrono::minutes(5)};
+        // While open no attempts are made; afterwards one trial attempt is
+        // allowed and the circuit re-opens if the module turns CRITICAL again
+        std::chrono::milliseconds circuitOpenTime{std::chrono::minutes(10)};
+        // Healthy this long resets escalation and closes the circuit
+        std::chrono::milliseconds stableTime{std::chrono::minutes(1)};
+    };
+    struct RemediationStatus {
+        int attempts;          // since the module was last stable
+        bool circuitOpen;
+        bool inFlight;
+        bool hasLastAction;
+        RemediationAction lastAction;
+        bool lastSucceeded;
+    };
+    // Performs the action; runs on the remediation thread, never under
+    // HealthMonitor locks. Returns true on success.
+    using RemediationHandler = std::function<bool(const std::string& moduleName, RemediationAction action)>;
+
+    // Pre-aggregated state for exporters, rebuilt by the monitor loop so
+    // readers never touch healthMutex
+    struct ModuleSample {
+        std::string name;
+        bool registered;           // false once unloaded; counters are kept
+        HealthStatus status;
+        int consecutiveFailures;
+        double responseTimeMs;
+        uint64_t totalLoads;
+        uint64_t totalUnloads;
+        uint64_t totalHotSwaps;
+        uint64_t failedOperations;
+        LatencySummary latency[kLatencyOperationCount];
+        ModuleMemoryUsage memory;  // image is zero once unloaded; heap is kept
+        uint64_t cpuTimeNs;        // inside ModuleCallScope, see ModuleCallScope::CpuClock
+        uint64_t timedCalls;
+    };
+    struct MetricsSnapshot {
+        std::chrono::system_clock::time_point generatedAt;
+        HealthStatus systemHealth;
+        std::vector<ModuleSample> modules;
+    };
+
+    // Stable per-name index into the metrics counters. IDs are never reused,
+    // so counters stay cumulative across unload/reload of the same module.
+    using ModuleId = uint32_t;
+    static constexpr ModuleId kInvalidModuleId = 0xFFFFFFFF;
+    static constexpr size_t kMaxTrackedModules = 1024;
+
     // Singleton instance
     static HealthMonitor& getInstance();
 
@@ -51,23 +165,88 @@ public:
     // Module health management
     void registerModule(const std::string& moduleName, 
                        std::function<bool()> healthCheckFunction);
+    // Push-based registration: the module beats on the returned slot and is
+    // never polled. Returns nullptr when all slots are taken.
+    HeartbeatSlot* registerHeartbeatModule(const std::string& moduleName);
     void unregisterModule(const std::string& moduleName);
     HealthCheckResult getModuleHealth(const std::string& moduleName) const;
     
     // Metrics management
+    // Assigns an ID on first use; kInvalidModuleId once the table is full
+    ModuleId getModuleId(const std::string& moduleName);
     void recordModuleLoad(const std::string& moduleName, 
-                         std::chrono::milliseconds loadTime);
-    void recordModuleUnload(const std::string& moduleName);
-    void recordHotSwap(const std::string& moduleName, bool success);
+                         std::chrono::nanoseconds loadTime);
+    void recordModuleUnload(const std::string& moduleName,
+                            std::chrono::nanoseconds unloadTime = std::chrono::nanoseconds(0));
+    void recordHotSwap(const std::string& moduleName, bool success,
+                       std::chrono::nanoseconds swapTime = std::chrono::nanoseconds(0));
+    // Lock-free variants for callers that cached the module's ID
+    void recordModuleLoad(ModuleId moduleId, std::chrono::nanoseconds loadTime);
+    void recordModuleUnload(ModuleId moduleId,
+                            std::chrono::nanoseconds unloadTime = std::chrono::nanoseconds(0));
+    void recordHotSwap(ModuleId moduleId, bool success,
+                       std::chrono::nanoseconds swapTime = std::chrono::nanoseconds(0));
     ModuleMetrics getModuleMetrics(const std::string& moduleName) const;
 
-    // System-wide health
+    LatencyBaseline getLatencyBaseline(const std::string& moduleName, BaselineKind kind) const;
+    // Forget what was learned, e.g. for a new version that is legitimately
+    // slower. Registering a module (load, hot swap) does this as well.
+    void resetLatencyBaseline(const std::string& moduleName);
+
+    // Latency distributions; `resetInterval` starts a new interval afterwards
+    LatencySnapshot getLatencySnapshot(const std::string& moduleName, LatencyOperation operation,
+                                       bool resetInterval = false);
+    // All modules merged
+    LatencySnapshot getSystemLatencySnapshot(LatencyOperation operation) const;
+
+    // Latest published snapshot (never null); lock-free for the caller
+    std::shared_ptr<const MetricsSnapshot> getMetricsSnapshot() const;
+    // Rebuild and publish now instead of waiting for the monitor loop
+    void publishMetricsSnapshot();
+    // Also mirror each published snapshot into a named POSIX shared-memory
+    // segment (see MetricsSegment.hpp); empty name = /hotswap_metrics.<pid>
+    bool enableSharedMemoryMetrics(const std::string& segmentName = "");
+    void disableSharedMemoryMetrics();
+    std::string getSharedMemoryMetricsName() const;
+
+    // Remediation - disabled until a handler is set (nullptr disables again)
+    void setRemediationHandler(RemediationHandler handler);
+    void setRemediationPolicy(const RemediationPolicy& policy);
+    RemediationStatus getRemediationStatus(const std::string& moduleName) const;
+
+    // Recent results and 1-minute/1-hour rollups per module, bounded in size.
+    // With a file the history survives restarts (call before registering).
+    HealthHistoryView getHealthHistory(const std::string& moduleName) const;
+    bool enableHealthHistoryFile(const std::string& path);
+
+    // System-wide health - lock-free, cheap enough for a readiness probe
     HealthStatus getSystemHealth() const;
+    size_t getModuleCount(HealthStatus status) const;
     void generateHealthReport() const;
 
     // Configuration
-    void setCheckInterval(std::chrono::seconds interval);
+    // Default per-module check interval; also paces system health updates
+    void setCheckInterval(std::chrono::milliseconds interval);
+    // Override the interval for one module (0 reverts to the default)
+    void setModuleCheckInterval(const std::string& moduleName, std::chrono::milliseconds interval);
+    // Each reschedule is spread by +/- fraction of the interval (default 0.1)
+    void setCheckJitter(double fraction);
     void setFailureThreshold(int threshold);
+    // A check still running after this is marked UNHEALTHY without waiting for it
+    void setCheckTimeout(std::chrono::milliseconds timeout);
+    // Size of the check worker pool (takes effect on the next startMonitoring)
+    void setCheckWorkers(size_t workers);
+    // Beats older than this mark a module UNHEALTHY (0 disables staleness checks)
+    void setHeartbeatTimeout(std::chrono::milliseconds timeout);
+    void setAdaptiveCheckPolicy(const AdaptiveCheckPolicy& policy);
+    // Thresholds for latency-based DEGRADED detection
+    void setDegradationPolicy(const LatencyBaseline::Policy& policy);
+    // Cap on checks started per second across all modules (0 = unlimited);
+    // checks over budget are deferred, not dropped
+    void setCheckBudget(double checksPerSecond);
+    CheckStats getCheckStats() const;
+    // How often the monitor loop republishes the metrics snapshot (default 1s)
+    void setMetricsPublishInterval(std::chrono::milliseconds interval);
 
     // Prevent copying
     HealthMonitor(const HealthMonitor&) = delete;
@@ -78,7 +257,46 @@ private:
     ~HealthMonitor();
 
     void monitoringLoop();
-    void performHealthChecks();
+    std::vector<std::string> collectDueChecks(std::chrono::steady_clock::time_point now);
+    void scheduleCheck(const std::string& moduleName, bool initial);
+    void unscheduleCheck(const std::string& moduleName, bool forgetInterval);
+    void scheduleImmediateCheck(const std::string& moduleName);
+    void noteCheckOutcome(const std::string& moduleName, const HealthCheckResult& previous,
+                          const HealthCheckResult& current);
+    bool takeCheckToken(std::chrono::steady_clock::time_point now);
+    bool updateBaseline(ModuleId moduleId, BaselineKind kind, std::chrono::nanoseconds latency);
+    void resetLatencyBaseline(ModuleId moduleId);
+    bool isLatencyDegraded(ModuleId moduleId) const;
+    void wakeMonitor();
+    // In-flight check; state decides whether the worker or the deadline wins
+    struct PendingCheck {
+        enum : uint32_t { RUNNING, COMPLETED, TIMED_OUT };
+        std::atomic<uint32_t> state{RUNNING};
+        std::atomic<bool> finished{false}; // worker has returned from module code
+        std::chrono::steady_clock::time_point deadline;
+        bool timedOut = false;             // monitor thread only
+    };
+
+    void performHealthChecks(const std::vector<std::string>& dueModules);
+    void runHealthCheck(const std::string& moduleName, const std::function<bool()>& checkFunction,
+                        const std::shared_ptr<PendingCheck>& pending);
+    void applyCheckResult(const std::string& moduleName, bool isHealthy, const std::string& error,
+                          std::chrono::steady_clock::time_point startTime,
+                          std::chrono::steady_clock::time_point endTime);
+    void recordCheckTimeout(const std::string& moduleName, std::chrono::nanoseconds timeout);
+    void expireOverdueChecks(std::chrono::steady_clock::time_point now);
+    std::chrono::steady_clock::time_point nextCheckDeadline() const;
+    void scanHeartbeats();
+    void initializeModuleState(const std::string& moduleName);
+    ModuleId findModuleId(const std::string& moduleName) const;
+    LatencyHistogram* latencyHistogram(ModuleId moduleId, LatencyOperation operation) const;
+    void releaseHeartbeatSlot(const std::string& moduleName);
+    void writeMetricsSegment(const MetricsSnapshot& snapshot);
+    void planRemediation(std::chrono::steady_clock::time_point now);
+    void runRemediation(const std::string& moduleName, RemediationAction action,
+                        const RemediationHandler& handler);
+    void storeModuleStatus(const std::string& moduleName, const HealthCheckResult& result);
+    void eraseModuleStatus(const std::string& moduleName);
     void updateSystemHealth();
     void checkForAlerts();
     void logHealthStatus();
@@ -88,14 +306,132 @@ private:
     
     std::atomic<bool> monitoring;
     std::thread monitorThread;
-    std::chrono::seconds checkInterval;
     int failureThreshold;
 
+    // Monitor thread sleeps here until the next timer or a stop/wake request
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    bool wakePending;
+
+    // Check scheduling - guarded by schedulerMutex
+    struct ScheduledCheck {
+        uint64_t timerId;
+        std::chrono::milliseconds interval; // 0 = use checkInterval (adaptive)
+        double stretch = 1.0;               // adaptive multiplier on checkInterval
+        uint32_t healthyStreak = 0;
+    };
+    mutable std::mutex schedulerMutex;
+    std::chrono::milliseconds checkInterval;
+    std::chrono::steady_clock::time_point nextSystemUpdate;
+    double checkJitter;
+    TimerWheel checkWheel;
+    std::unordered_map<std::string, ScheduledCheck> scheduledChecks;
+    std::unordered_map<uint64_t, std::string> timerOwners;
+    uint64_t nextTimerId;
+    std::mt19937 jitterRng;
+    AdaptiveCheckPolicy adaptivePolicy;
+
     mutable std::mutex healthMutex;
     std::unordered_map<std::string, std::function<bool()>> healthChecks;
     std::unordered_map<std::string, HealthCheckResult> healthStatus;
-    std::unordered_map<std::string, ModuleMetrics> moduleMetrics;
+    // Maintained alongside healthStatus so system health never needs a rescan
+    std::atomic<uint32_t> statusCounts[4];
+    std::unordered_set<std::string> criticalModules;
+    HealthHistory healthHistory; // internally synchronized
+
+    // Operation counters live in per-thread blocks indexed by module ID; a
+    // block is written by one thread at a time and only summed on read.
+    enum CounterKind { LOADS, UNLOADS, HOT_SWAPS, FAILED_OPERATIONS, kCounterKinds };
+    struct CounterBlock {
+        std::atomic<uint64_t> counters[kMaxTrackedModules][kCounterKinds];
+        std::atomic<bool> inUse{false}; // leased by a live thread
+    };
+    CounterBlock& localCounterBlock();
+    uint64_t sumCounter(ModuleId moduleId, CounterKind kind) const;
+    mutable std::mutex blockMutex;
+    std::vector<std::unique_ptr<CounterBlock>> counterBlocks;
+
+    // Module IDs - assignment guarded by idMutex (never taken while recording
+    // by ID); per-ID state is published before the ID is handed out
+    struct ModuleLatency {
+        LatencyHistogram histograms[kLatencyOperationCount];
+    };
+    mutable std::mutex idMutex;
+    std::unordered_map<std::string, ModuleId> moduleIds;
+    std::vector<std::string> moduleNames; // by ID
+    std::atomic<uint32_t> moduleIdCount;
+    std::unique_ptr<std::unique_ptr<ModuleLatency>[]> moduleLatency;
+    std::unique_ptr<std::atomic<int64_t>[]> lastOperationNs;
+
+    // Latency baselines by module ID, each guarded by its own spin flag
+    struct ModuleBaselines {
+        mutable std::atomic_flag busy = ATOMIC_FLAG_INIT;
+        LatencyBaseline check;
+    };
+    std::unique_ptr<ModuleBaselines[]> moduleBaselines;
+    std::shared_ptr<const LatencyBaseline::Policy> degradationPolicy; // std::atomic_load/store
+
+    // Heartbeat slots - scanned lock-free, owners/free list guarded by healthMutex
+    std::unique_ptr<HeartbeatSlot[]> heartbeatSlots;
+    std::atomic<size_t> heartbeatHighWater;
+    std::vector<std::string> heartbeatOwners;
+    std::unordered_map<std::string, size_t> heartbeatIndex;
+    std::vector<size_t> freeHeartbeatSlots;
+    std::atomic<int64_t> heartbeatTimeoutNs;
+
+    // Parallel checks - pendingChecks is touched by the monitor thread only
+    std::unique_ptr<WorkerPool> checkPool;
+    std::atomic<size_t> checkWorkers;
+    std::atomic<int64_t> checkTimeoutNs;
+    std::unordered_map<std::string, std::shared_ptr<PendingCheck>> pendingChecks;
+
+    // Check budget - token bucket and deferred queue owned by the monitor thread
+    std::atomic<double> checkBudget;
+    double budgetTokens;
+    std::chrono::steady_clock::time_point budgetRefill;
+    std::deque<std::string> deferredChecks;
+    std::chrono::steady_clock::time_point nextDeferredCheck;
+
+    // Check stats
+    std::atomic<uint64_t> checksStarted;
+    std::atomic<uint64_t> checksDeferred;
+    std::atomic<uint64_t> detections;
+    std::atomic<double> achievedCheckRate;
+    uint64_t rateSampleChecks;                      // monitor thread only
+    std::chrono::steady_clock::time_point rateSampleTime;
+    LatencyHistogram checkIntervalAtDetection;
     
-    HealthStatus systemHealth;
+    std::atomic<HealthStatus> systemHealth; // written under healthMutex
     std::chrono::steady_clock::time_point lastSystemCheck;
+
+    // Remediation - state guarded by healthMutex, wake time by the monitor thread
+    struct RemediationState {
+        int attempts = 0;
+        std::deque<std::chrono::steady_clock::time_point> window; // attempts within budgetWindow
+        std::chrono::steady_clock::time_point nextAttempt{};
+        std::chrono::milliseconds backoff{0}; // counted from when the attempt finishes
+        std::chrono::steady_clock::time_point circuitOpenUntil{};
+        std::chrono::steady_clock::time_point healthySince{};
+        bool circuitOpen = false;
+        bool halfOpen = false;
+        bool halfOpenAttempted = false;
+        bool inFlight = false;
+        bool hasLastAction = false;
+        RemediationAction lastAction = RemediationAction::RESTART_INSTANCE;
+        bool lastSucceeded = false;
+    };
+    RemediationHandler remediationHandler;
+    RemediationPolicy remediationPolicy;
+    std::unordered_map<std::string, RemediationState> remediationStates;
+    std::unique_ptr<WorkerPool> remediationPool;
+    std::chrono::steady_clock::time_point nextRemediationDue;
+
+    // Published with std::atomic_store; guarded by schedulerMutex: the interval
+    std::shared_ptr<const MetricsSnapshot> latestMetrics;
+    std::chrono::milliseconds metricsPublishInterval;
+    std::chrono::steady_clock::time_point nextMetricsPublish;
+    // Serializes publishers (the segment's seqlocks allow one writer)
+    mutable std::mutex publishMutex;
+    metrics_segment::Segment* metricsSegment;
+    std::string metricsSegmentName;
 };
\ No newline at end of file
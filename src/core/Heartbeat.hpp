@@ -0,0 +1,43 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Host-provided slot a module writes its health into (push model).
+// HealthMonitor keeps these in one contiguous array and scans them without
+// calling into module code. A slot's first cache line is the module's, so a
+// module beating on its slot never bounces a line shared with a neighbour;
+// the host's own bookkeeping sits on a second line the module never writes.
+struct alignas(64) HeartbeatSlot {
+    enum Status : uint32_t {
+        HEALTHY = 0,
+        DEGRADED = 1,
+        UNHEALTHY = 2,
+        UNOBSERVED = 0xFFFFFFFF, // host-side marker: nothing published yet
+        DRIFTING = 0xFFFFFFFE    // host-side marker: healthy beat, call latency degraded
+    };
+
+    std::atomic<uint64_t> timestampNs{0}; // steady_clock ns of the last beat
+    std::atomic<uint32_t> status{HEALTHY};
+    std::atomic<uint32_t> load{0};        // module-defined load value
+    std::atomic<uint32_t> active{0};      // set by the host while assigned
+
+    // host-side: last status the monitor published, and the owner's metrics
+    // ID so the scan can consult latency drift without taking a lock
+    alignas(64) std::atomic<uint32_t> observed{0};
+    std::atomic<uint32_t> moduleId{0xFFFFFFFF};
+
+    static uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Called by the module - two relaxed stores and a release store
+    void beat(Status newStatus, uint32_t loadValue = 0) {
+        status.store(newStatus, std::memory_order_relaxed);
+        load.store(loadValue, std::memory_order_relaxed);
+        timestampNs.store(nowNs(), std::memory_order_release);
+    }
+};
+
+static_assert(sizeof(HeartbeatSlot) == 128, "HeartbeatSlot must be one module line plus one host line");
@@ -1,6 +1,7 @@
 #pragma once 
 #include <string>
 #include <vector>
+#include "Heartbeat.hpp"
 
 class IModule {
 public: 
@@ -19,4 +20,12 @@ public:
     virtual std::vector<std::string> getDependencies() {
         return {}; // default empty dependencies
     };
+
+    // Push-based health: return true to publish health through the slot
+    // instead of being polled via isHealthy(). Called with nullptr before
+    // the module is stopped for good - stop writing to the old slot then.
+    virtual bool attachHeartbeat(HeartbeatSlot* slot) {
+        (void)slot;
+        return false; // default: polled health checks
+    }
 };
\ No newline at end of file
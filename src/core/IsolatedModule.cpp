@@ -0,0 +1,257 @@
+#include "IsolatedModule.hpp"
+#include "../utils/Logger.hpp"
+#include <csignal>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <thread>
+
+extern char** environ;
+
+namespace {
+constexpr int kWorkerLost = -2;
+constexpr auto kPollSlice = std::chrono::microseconds(50000);
+constexpr auto kStartupTimeout = std::chrono::milliseconds(5000);
+}
+
+IsolatedModule::IsolatedModule(const std::string& libPath, const std::string& worker)
+    : libraryPath(libPath), workerPath(worker) {
+}
+
+IsolatedModule::~IsolatedModule() {
+    {
+        std::lock_guard<std::mutex> lock(callMutex);
+        if (workerPid > 0) {
+            callLocked(ipc::Opcode::SHUTDOWN, nullptr);
+            reapWorker(false);
+        }
+    }
+
+    if (channel) {
+        munmap(channel, sizeof(ipc::Channel));
+        channel = nullptr;
+    }
+    if (channelFd >= 0) {
+        close(channelFd);
+        channelFd = -1;
+    }
+}
+
+bool IsolatedModule::launch() {
+    auto& logger = Logger::getInstance();
+
+    channelFd = memfd_create("hotswap_ipc", MFD_CLOEXEC); // handed to the worker alone at spawn
+    if (channelFd < 0 || ftruncate(channelFd, sizeof(ipc::Channel)) != 0) {
+        logger.error("Failed to create IPC channel for: " + libraryPath, "IsolatedModule");
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, sizeof(ipc::Channel), PROT_READ | PROT_WRITE,
+                         MAP_SHARED, channelFd, 0);
+    if (mapping == MAP_FAILED) {
+        logger.error("Failed to map IPC channel for: " + libraryPath, "IsolatedModule");
+        return false;
+    }
+    channel = static_cast<ipc::Channel*>(mapping);
+    channel->reset();
+
+    std::lock_guard<std::mutex> lock(callMutex);
+    return spawnWorker();
+}
+
+bool IsolatedModule::spawnWorker() {
+    auto& logger = Logger::getInstance();
+
+    std::string fdArg = std::to_string(channelFd);
+    char* argv[] = {
+        const_cast<char*>(workerPath.c_str()),
+        const_cast<char*>(libraryPath.c_str()),
+        const_cast<char*>(fdArg.c_str()),
+        nullptr
+    };
+
+    // dup2 onto itself clears close-on-exec in the worker only, so other
+    // processes the host spawns never inherit the channel
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, channelFd, channelFd);
+
+    pid_t pid = -1;
+    int rc = posix_spawn(&pid, workerPath.c_str(), &actions, nullptr, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (rc != 0) {
+        logger.error("Failed to spawn module worker " + workerPath + ": " + std::strerror(rc),
+                     "IsolatedModule");
+        return false;
+    }
+    workerPid = pid;
+
+    // Wait for READY; payload carries "name\nversion"
+    auto deadline = std::chrono::steady_clock::now() + kStartupTimeout;
+    ipc::Message ready;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (channel->responses.pop(ready, kPollSlice)) {
+            if (ready.opcode != static_cast<uint32_t>(ipc::Opcode::READY) || ready.status != 1) {
+                logger.error("Module worker failed to load: " + libraryPath + " - " +
+                             std::string(ready.payload, ready.length), "IsolatedModule");
+                reapWorker(false);
+                return false;
+            }
+
+            std::string identity(ready.payload, ready.length);
+            auto split = identity.find('\n');
+            name = identity.substr(0, split);
+            version = split == std::string::npos ? "" : identity.substr(split + 1);
+
+            logger.info("Module worker ready: " + name + " (pid " + std::to_string(workerPid) + ")",
+                        "IsolatedModule");
+            return true;
+        }
+        if (!workerAlive()) {
+            logger.error("Module worker exited during startup: " + libraryPath, "IsolatedModule");
+            return false;
+        }
+    }
+
+    logger.error("Module worker startup timed out: " + libraryPath, "IsolatedModule");
+    reapWorker(true);
+    return false;
+}
+
+bool IsolatedModule::workerAlive() {
+    if (workerPid <= 0) {
+        return false;
+    }
+    int status = 0;
+    pid_t rc = waitpid(workerPid, &status, WNOHANG);
+    if (rc == 0) {
+        return true;
+    }
+    workerPid = -1;
+    return false;
+}
+
+void IsolatedModule::reapWorker(bool force) {
+    if (workerPid <= 0) {
+        return;
+    }
+
+    if (!force) {
+        // Give a graceful SHUTDOWN a moment to finish
+        for (int i = 0; i < 100 && workerAlive(); i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        if (workerPid <= 0) {
+            return;
+        }
+    }
+
+    kill(workerPid, SIGKILL);
+    int status = 0;
+    waitpid(workerPid, &status, 0);
+    workerPid = -1;
+}
+
+bool IsolatedModule::restartWorker() {
+    auto& logger = Logger::getInstance();
+    logger.warning("Module worker lost, restarting: " + name, "IsolatedModule");
+
+    reapWorker(true);
+    channel->reset();
+    restartCount++;
+
+    if (!spawnWorker()) {
+        logger.error("Module worker restart failed: " + name, "IsolatedModule");
+        return false;
+    }
+
+    // Replay lifecycle so the new instance matches the one that crashed
+    if (initialized && callLocked(ipc::Opcode::INIT, nullptr) != 1) {
+        logger.error("Init replay failed after restart: " + name, "IsolatedModule");
+        return false;
+    }
+    if (started && callLocked(ipc::Opcode::START, nullptr) != 1) {
+        logger.error("Start replay failed after restart: " + name, "IsolatedModule");
+        return false;
+    }
+
+    logger.info("Module worker restarted: " + name + " (restarts: " +
+                std::to_string(restartCount) + ")", "IsolatedModule");
+    return true;
+}
+
+int IsolatedModule::callLocked(ipc::Opcode opcode, ipc::Message* response) {
+    if (!channel || workerPid <= 0) {
+        return kWorkerLost;
+    }
+
+    ipc::Message request{};
+    request.opcode = static_cast<uint32_t>(opcode);
+    request.sequence = nextSequence++;
+
+    auto deadline = std::chrono::steady_clock::now() + callTimeout;
+    while (!channel->requests.tryPush(request)) {
+        if (!workerAlive() || std::chrono::steady_clock::now() >= deadline) {
+            return kWorkerLost;
+        }
+        std::this_thread::yield();
+    }
+
+    ipc::Message reply;
+    while (true) {
+        if (channel->responses.pop(reply, kPollSlice)) {
+            if (reply.sequence != request.sequence) {
+                continue; // stale reply from an abandoned call
+            }
+            if (response) {
+                *response = reply;
+            }
+            return reply.status;
+        }
+        if (!workerAlive()) {
+            return kWorkerLost;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            // Hung worker is as bad as a dead one
+            reapWorker(true);
+            return kWorkerLost;
+        }
+    }
+}
+
+int IsolatedModule::call(ipc::Opcode opcode) {
+    std::lock_guard<std::mutex> lock(callMutex);
+
+    int status = callLocked(opcode, nullptr);
+    if (status == kWorkerLost && opcode != ipc::Opcode::SHUTDOWN) {
+        // The in-flight call is reported as failed; the next one hits the new worker
+        restartWorker();
+    }
+    return status;
+}
+
+bool IsolatedModule::init() {
+    bool ok = call(ipc::Opcode::INIT) == 1;
+    initialized = ok;
+    return ok;
+}
+
+bool IsolatedModule::start() {
+    bool ok = call(ipc::Opcode::START) == 1;
+    started = ok;
+    return ok;
+}
+
+bool IsolatedModule::stop() {
+    started = false;
+    return call(ipc::Opcode::STOP) == 1;
+}
+
+bool IsolatedModule::cleanup() {
+    initialized = false;
+    return call(ipc::Opcode::CLEANUP) == 1;
+}
+
+bool IsolatedModule::isHealthy() {
+    return call(ipc::Opcode::IS_HEALTHY) == 1;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <string>
+#include <mutex>
+#include <chrono>
+#include <sys/types.h>
+#include "IModule.hpp"
+#include "SharedMemoryRing.hpp"
+
+// Host-side proxy for a module running in its own worker process.
+// The worker loads the .so and answers lifecycle calls over a shared-memory
+// ring pair, so a crash inside the module only kills the worker. A crashed
+// worker is restarted transparently and its init/start sequence replayed.
+class IsolatedModule : public IModule {
+private:
+    std::string libraryPath;
+    std::string workerPath;
+    std::string name;
+    std::string version;
+
+    int channelFd = -1;
+    ipc::Channel* channel = nullptr;
+    pid_t workerPid = -1;
+
+    std::mutex callMutex; // SPSC - one in-flight call at a time
+    uint32_t nextSequence = 1;
+
+    bool initialized = false;
+    bool started = false;
+    size_t restartCount = 0;
+
+    std::chrono::milliseconds callTimeout{5000};
+
+    bool spawnWorker();
+    void reapWorker(bool force);
+    bool workerAlive();
+    bool restartWorker();
+    int call(ipc::Opcode opcode);
+    int callLocked(ipc::Opcode opcode, ipc::Message* response);
+
+public:
+    IsolatedModule(const std::string& libraryPath, const std::string& workerPath);
+    ~IsolatedModule() override;
+
+    // Spawns the worker and waits for its READY message.
+    bool launch();
+
+    bool init() override;
+    bool start() override;
+    bool stop() override;
+    bool cleanup() override;
+
+    std::string getName() override { return name; }
+    std::string getVersion() override { return version; }
+
+    bool isHealthy() override;
+
+    pid_t getWorkerPid() const { return workerPid; }
+    size_t getRestartCount() const { return restartCount; }
+    void setCallTimeout(std::chrono::milliseconds timeout) { callTimeout = timeout; }
+
+    IsolatedModule(const IsolatedModule&) = delete;
+    IsolatedModule& operator=(const IsolatedModule&) = delete;
+};
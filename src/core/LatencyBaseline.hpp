@@ -0,0 +1,62 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Learned latency baseline with drift detection in constant memory. A slow
+// EWMA (with EWM variance) tracks what is normal for the module, a fast EWMA
+// tracks what it is doing now. The module is drifting while the fast mean is
+// above every configured limit. Samples beyond the limit are never learned:
+// one outlier would otherwise inflate the variance enough to hide a real
+// slowdown, and a sustained slowdown would be absorbed as the new normal.
+struct LatencyBaseline {
+    struct Policy {
+        bool enabled = true;
+        double fastAlpha = 0.2;       // weight of a new sample in the recent mean
+        double baselineAlpha = 0.01;  // weight of a new sample in the baseline
+        uint32_t warmupSamples = 30;  // exact mean/variance before judging
+        double sigmaThreshold = 4.0;  // drift needs recent > mean + k * stddev ...
+        double ratioThreshold = 2.0;  // ... and recent > mean * ratio ...
+        double minDriftNs = 100000;   // ... and recent > mean + this (jitter floor)
+    };
+
+    double recentNs = 0;
+    double meanNs = 0;
+    double varianceNs2 = 0;
+    uint64_t samples = 0;
+    bool drifting = false;
+
+    bool update(double valueNs, const Policy& policy) {
+        samples++;
+        if (samples == 1) {
+            recentNs = meanNs = valueNs;
+            varianceNs2 = 0;
+            return drifting = false;
+        }
+
+        recentNs += policy.fastAlpha * (valueNs - recentNs);
+        if (samples <= policy.warmupSamples) {
+            learn(valueNs, 1.0 / static_cast<double>(samples));
+            return drifting = false;
+        }
+
+        double limit = std::max({meanNs + policy.sigmaThreshold * stddevNs(),
+                                 meanNs * policy.ratioThreshold,
+                                 meanNs + policy.minDriftNs});
+        drifting = recentNs > limit;
+        if (!drifting && valueNs <= limit) {
+            learn(valueNs, policy.baselineAlpha);
+        }
+        return drifting;
+    }
+
+    double stddevNs() const { return std::sqrt(varianceNs2); }
+
+private:
+    void learn(double valueNs, double alpha) {
+        double diff = valueNs - meanNs;
+        double increment = alpha * diff;
+        meanNs += increment;
+        varianceNs2 = (1.0 - alpha) * (varianceNs2 + diff * increment);
+    }
+};
@@ -0,0 +1,119 @@
+#include "LatencyHistogram.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace {
+constexpr uint64_t kNoMin = std::numeric_limits<uint64_t>::max();
+}
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < 2 * kSubBucketCount) {
+        return index;
+    }
+    uint64_t shift = index / kSubBucketCount - 1;
+    uint64_t subBucket = index - shift * kSubBucketCount;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+LatencySnapshot LatencyHistogram::snapshot() const {
+    LatencySnapshot result;
+    for (size_t i = 0; i < kBucketCount; i++) {
+        result.counts[i] = counts[i].load(std::memory_order_relaxed);
+    }
+    result.totalCount = totalCount.load(std::memory_order_relaxed);
+    result.sumNs = sumNs.load(std::memory_order_relaxed);
+    uint64_t min = minNs.load(std::memory_order_relaxed);
+    result.minNs = min == kNoMin ? 0 : min;
+    result.maxNs = maxNs.load(std::memory_order_relaxed);
+    return result;
+}
+
+LatencySnapshot LatencyHistogram::snapshotAndReset() {
+    LatencySnapshot result;
+    for (size_t i = 0; i < kBucketCount; i++) {
+        result.counts[i] = counts[i].exchange(0, std::memory_order_relaxed);
+    }
+    result.totalCount = totalCount.exchange(0, std::memory_order_relaxed);
+    result.sumNs = sumNs.exchange(0, std::memory_order_relaxed);
+    uint64_t min = minNs.exchange(kNoMin, std::memory_order_relaxed);
+    result.minNs = min == kNoMin ? 0 : min;
+    result.maxNs = maxNs.exchange(0, std::memory_order_relaxed);
+    return result;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& count : counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    totalCount.store(0, std::memory_order_relaxed);
+    sumNs.store(0, std::memory_order_relaxed);
+    minNs.store(kNoMin, std::memory_order_relaxed);
+    maxNs.store(0, std::memory_order_relaxed);
+}
+
+void LatencySnapshot::merge(const LatencySnapshot& other) {
+    if (other.totalCount == 0) {
+        return;
+    }
+    for (size_t i = 0; i < kBucketCount; i++) {
+        counts[i] += other.counts[i];
+    }
+    minNs = totalCount == 0 ? other.minNs : std::min(minNs, other.minNs);
+    maxNs = std::max(maxNs, other.maxNs);
+    totalCount += other.totalCount;
+    sumNs += other.sumNs;
+}
+
+uint64_t LatencySnapshot::percentile(double p) const {
+    // Bucket counts are read one by one while recorders keep going, so sum
+    // them instead of trusting totalCount
+    uint64_t bucketTotal = 0;
+    for (uint64_t count : counts) {
+        bucketTotal += count;
+    }
+    if (bucketTotal == 0) {
+        return 0;
+    }
+
+    p = std::min(std::max(p, 0.0), 100.0);
+    uint64_t target = static_cast<uint64_t>(p / 100.0 * bucketTotal + 0.5);
+    target = std::max<uint64_t>(target, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; i++) {
+        seen += counts[i];
+        if (seen >= target) {
+            return std::min(LatencyHistogram::bucketUpperBound(i), maxNs ? maxNs : UINT64_MAX);
+        }
+    }
+    return maxNs;
+}
+
+LatencySummary LatencySummary::from(const LatencySnapshot& snapshot) {
+    LatencySummary summary;
+    size_t bound = 0;
+    uint64_t running = 0;
+    for (size_t i = 0; i < LatencySnapshot::kBucketCount; i++) {
+        uint64_t upper = LatencyHistogram::bucketUpperBound(i);
+        while (bound < kBoundCount && upper > kBoundsNs[bound]) {
+            summary.cumulative[bound++] = running;
+        }
+        running += snapshot.counts[i];
+    }
+    while (bound < kBoundCount) {
+        summary.cumulative[bound++] = running;
+    }
+
+    // Buckets are the source of truth so count matches the +Inf bucket
+    summary.count = running;
+    summary.sumNs = snapshot.sumNs;
+    summary.p50Ns = snapshot.p50();
+    summary.p99Ns = snapshot.p99();
+    summary.p999Ns = snapshot.p999();
+    summary.maxNs = snapshot.maxNs;
+    return summary;
+}
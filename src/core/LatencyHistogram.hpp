@@ -0,0 +1,102 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// HDR-style log-linear latency histogram with nanosecond resolution.
+// Values below 64ns get exact buckets; above that every power of two is
+// split into 32 linear sub-buckets (~3% relative error) up to 2^36 ns (~68s),
+// larger values land in the last bucket. Recording is a handful of relaxed
+// atomic operations - no locks, no allocation.
+
+struct LatencySnapshot {
+    static constexpr size_t kBucketCount = 1024;
+
+    std::array<uint64_t, kBucketCount> counts{};
+    uint64_t totalCount = 0;
+    uint64_t sumNs = 0;
+    uint64_t minNs = 0;
+    uint64_t maxNs = 0;
+
+    void merge(const LatencySnapshot& other);
+
+    // Highest value equivalent to the given percentile (0-100)
+    uint64_t percentile(double p) const;
+    uint64_t p50() const { return percentile(50.0); }
+    uint64_t p99() const { return percentile(99.0); }
+    uint64_t p999() const { return percentile(99.9); }
+    double meanNs() const { return totalCount ? static_cast<double>(sumNs) / totalCount : 0.0; }
+};
+
+// Compact view for exporters: cumulative counts at fixed decade bounds
+// (1us .. 10s) plus a few percentiles. Bucket edges do not line up exactly
+// with the decades, so a value within ~3% of a bound may count one bound up.
+struct LatencySummary {
+    static constexpr size_t kBoundCount = 8;
+    static constexpr uint64_t kBoundsNs[kBoundCount] = {
+        1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000
+    };
+
+    uint64_t cumulative[kBoundCount] = {}; // observations <= kBoundsNs[i]
+    uint64_t count = 0;
+    uint64_t sumNs = 0;
+    uint64_t p50Ns = 0;
+    uint64_t p99Ns = 0;
+    uint64_t p999Ns = 0;
+    uint64_t maxNs = 0;
+
+    static LatencySummary from(const LatencySnapshot& snapshot);
+};
+
+class LatencyHistogram {
+public:
+    static constexpr size_t kBucketCount = LatencySnapshot::kBucketCount;
+    static constexpr uint32_t kSubBucketBits = 5;
+    static constexpr uint64_t kSubBucketCount = 1u << kSubBucketBits;
+
+    LatencyHistogram();
+
+    void record(uint64_t valueNs) {
+        counts[bucketIndex(valueNs)].fetch_add(1, std::memory_order_relaxed);
+        totalCount.fetch_add(1, std::memory_order_relaxed);
+        sumNs.fetch_add(valueNs, std::memory_order_relaxed);
+
+        uint64_t currentMin = minNs.load(std::memory_order_relaxed);
+        while (valueNs < currentMin &&
+               !minNs.compare_exchange_weak(currentMin, valueNs, std::memory_order_relaxed)) {
+        }
+        uint64_t currentMax = maxNs.load(std::memory_order_relaxed);
+        while (valueNs > currentMax &&
+               !maxNs.compare_exchange_weak(currentMax, valueNs, std::memory_order_relaxed)) {
+        }
+    }
+
+    LatencySnapshot snapshot() const;
+    // Snapshot for the interval since the last reset, then start a new one
+    LatencySnapshot snapshotAndReset();
+    void reset();
+
+    static size_t bucketIndex(uint64_t valueNs) {
+        if (valueNs < 2 * kSubBucketCount) {
+            return static_cast<size_t>(valueNs);
+        }
+        uint32_t msb = 63 - static_cast<uint32_t>(__builtin_clzll(valueNs));
+        uint32_t shift = msb - kSubBucketBits;
+        size_t index = static_cast<size_t>(shift) * kSubBucketCount + static_cast<size_t>(valueNs >> shift);
+        return index < kBucketCount ? index : kBucketCount - 1;
+    }
+
+    // Inclusive upper bound of the values that map to a bucket
+    static uint64_t bucketUpperBound(size_t index);
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+private:
+    std::atomic<uint64_t> counts[kBucketCount];
+    std::atomic<uint64_t> totalCount;
+    std::atomic<uint64_t> sumNs;
+    std::atomic<uint64_t> minNs;
+    std::atomic<uint64_t> maxNs;
+};
@@ -0,0 +1,350 @@
+#include "MetricsExporter.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+namespace {
+
+const char* kOperationNames[HealthMonitor::kLatencyOperationCount] = {
+    "load", "unload", "hot_swap", "health_check"
+};
+
+std::string escapeLabel(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        switch (c) {
+            case '\\': escaped += "\\\\"; break;
+            case '"': escaped += "\\\""; break;
+            case '\n': escaped += "\\n"; break;
+            default: escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::string seconds(uint64_t nanoseconds) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.9g", nanoseconds / 1e9);
+    return buffer;
+}
+
+int statusValue(HealthMonitor::HealthStatus status) {
+    return static_cast<int>(status); // HEALTHY=0 .. CRITICAL=3
+}
+
+bool writeAll(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = send(fd, data, length, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+} // namespace
+
+MetricsExporter::MetricsExporter()
+    : listenFd(-1), wakePipe{-1, -1}, running(false), port(0) {
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+bool MetricsExporter::listenUnix(const std::string& path) {
+    auto& logger = Logger::getInstance();
+
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        logger.error("Metrics socket path too long: " + path, "MetricsExporter");
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        logger.error("Failed to create metrics socket: " + std::string(strerror(errno)), "MetricsExporter");
+        return false;
+    }
+    unlink(path.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(fd, 16) != 0) {
+        logger.error("Failed to listen on " + path + ": " + std::string(strerror(errno)), "MetricsExporter");
+        close(fd);
+        return false;
+    }
+
+    socketPath = path;
+    if (!startServing(fd)) {
+        return false;
+    }
+    logger.info("Metrics exporter listening on unix:" + path, "MetricsExporter");
+    return true;
+}
+
+bool MetricsExporter::listenLoopback(uint16_t requestedPort) {
+    auto& logger = Logger::getInstance();
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        logger.error("Failed to create metrics socket: " + std::string(strerror(errno)), "MetricsExporter");
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(requestedPort);
+    socklen_t length = sizeof(address);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(fd, 16) != 0 ||
+        getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        logger.error("Failed to listen on port " + std::to_string(requestedPort) + ": " +
+                     std::string(strerror(errno)), "MetricsExporter");
+        close(fd);
+        return false;
+    }
+
+    port = ntohs(address.sin_port);
+    if (!startServing(fd)) {
+        return false;
+    }
+    logger.info("Metrics exporter listening on 127.0.0.1:" + std::to_string(port), "MetricsExporter");
+    return true;
+}
+
+bool MetricsExporter::startServing(int fd) {
+    if (running) {
+        Logger::getInstance().warning("Metrics exporter already running", "MetricsExporter");
+        close(fd);
+        return false;
+    }
+    if (pipe2(wakePipe, O_CLOEXEC) != 0) {
+        Logger::getInstance().error("Failed to create exporter wake pipe", "MetricsExporter");
+        close(fd);
+        return false;
+    }
+
+    listenFd = fd;
+    running = true;
+    serverThread = std::thread(&MetricsExporter::serveLoop, this);
+    return true;
+}
+
+void MetricsExporter::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+
+    char wake = 1;
+    ssize_t ignored = write(wakePipe[1], &wake, 1);
+    (void)ignored;
+    if (serverThread.joinable()) {
+        serverThread.join();
+    }
+
+    close(listenFd);
+    close(wakePipe[0]);
+    close(wakePipe[1]);
+    listenFd = -1;
+    wakePipe[0] = wakePipe[1] = -1;
+    if (!socketPath.empty()) {
+        unlink(socketPath.c_str());
+        socketPath.clear();
+    }
+    port = 0;
+
+    Logger::getInstance().info("Metrics exporter stopped", "MetricsExporter");
+}
+
+bool MetricsExporter::isRunning() const {
+    return running;
+}
+
+uint16_t MetricsExporter::getPort() const {
+    return port;
+}
+
+void MetricsExporter::serveLoop() {
+    pollfd fds[2] = {{listenFd, POLLIN, 0}, {wakePipe[0], POLLIN, 0}};
+    while (running) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            Logger::getInstance().error("Metrics exporter poll failed: " + std::string(strerror(errno)),
+                                        "MetricsExporter");
+            break;
+        }
+        if (fds[1].revents) {
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            int clientFd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (clientFd >= 0) {
+                handleClient(clientFd);
+                close(clientFd);
+            }
+        }
+    }
+}
+
+// One request per connection; a slow client can hold the exporter for at
+// most the receive timeout
+void MetricsExporter::handleClient(int clientFd) {
+    timeval timeout{1, 0};
+    setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(clientFd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+        ssize_t received = recv(clientFd, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        request.append(buffer, static_cast<size_t>(received));
+    }
+
+    std::string status = "200 OK";
+    std::string contentType = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+    std::string body;
+    if (request.compare(0, 4, "GET ") != 0) {
+        status = "405 Method Not Allowed";
+        contentType = "text/plain";
+        body = "Only GET is supported\n";
+    } else {
+        std::string target = request.substr(4, request.find(' ', 4) - 4);
+        if (target == "/metrics" || target == "/") {
+            body = render(*HealthMonitor::getInstance().getMetricsSnapshot());
+        } else {
+            status = "404 Not Found";
+            contentType = "text/plain";
+            body = "Not found\n";
+        }
+    }
+
+    std::string response = "HTTP/1.0 " + status + "\r\n"
+                           "Content-Type: " + contentType + "\r\n"
+                           "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                           "Connection: close\r\n\r\n" + body;
+    writeAll(clientFd, response.data(), response.size());
+}
+
+std::string MetricsExporter::render(const HealthMonitor::MetricsSnapshot& snapshot) {
+    std::string out;
+    out.reserve(1024 + snapshot.modules.size() * 4096);
+
+    out += "# TYPE hotswap_system_health_status gauge\n"
+           "# HELP hotswap_system_health_status Overall health: 0=healthy 1=degraded 2=unhealthy 3=critical.\n";
+    out += "hotswap_system_health_status " + std::to_string(statusValue(snapshot.systemHealth)) + "\n";
+
+    out += "# TYPE hotswap_module_health_status gauge\n"
+           "# HELP hotswap_module_health_status Module health: 0=healthy 1=degraded 2=unhealthy 3=critical.\n";
+    for (const auto& module : snapshot.modules) {
+        if (module.registered) {
+            out += "hotswap_module_health_status{module=\"" + escapeLabel(module.name) + "\"} " +
+                   std::to_string(statusValue(module.status)) + "\n";
+        }
+    }
+
+    out += "# TYPE hotswap_module_consecutive_failures gauge\n"
+           "# HELP hotswap_module_consecutive_failures Failed health checks in a row.\n";
+    for (const auto& module : snapshot.modules) {
+        if (module.registered) {
+            out += "hotswap_module_consecutive_failures{module=\"" + escapeLabel(module.name) + "\"} " +
+                   std::to_string(module.consecutiveFailures) + "\n";
+        }
+    }
+
+    struct Counter {
+        const char* name;
+        const char* help;
+        uint64_t HealthMonitor::ModuleSample::*field;
+    };
+    const Counter counters[] = {
+        {"hotswap_module_loads", "Module loads.", &HealthMonitor::ModuleSample::totalLoads},
+        {"hotswap_module_unloads", "Module unloads.", &HealthMonitor::ModuleSample::totalUnloads},
+        {"hotswap_module_hot_swaps", "Hot-swap attempts.", &HealthMonitor::ModuleSample::totalHotSwaps},
+        {"hotswap_module_failed_operations", "Failed hot-swaps.", &HealthMonitor::ModuleSample::failedOperations},
+        {"hotswap_module_timed_calls", "Calls made inside a module call scope.", &HealthMonitor::ModuleSample::timedCalls},
+    };
+    for (const auto& counter : counters) {
+        out += std::string("# TYPE ") + counter.name + " counter\n";
+        out += std::string("# HELP ") + counter.name + " " + counter.help + "\n";
+        for (const auto& module : snapshot.modules) {
+            out += std::string(counter.name) + "_total{module=\"" + escapeLabel(module.name) + "\"} " +
+                   std::to_string(module.*counter.field) + "\n";
+        }
+    }
+
+    struct MemoryGauge {
+        const char* name;
+        const char* help;
+        uint64_t ModuleMemoryUsage::*field;
+    };
+    const MemoryGauge memoryGauges[] = {
+        {"hotswap_module_mapped_bytes", "Bytes mapped for the module image.", &ModuleMemoryUsage::mappedBytes},
+        {"hotswap_module_resident_bytes", "Resident bytes of the module image.", &ModuleMemoryUsage::residentBytes},
+        {"hotswap_module_heap_bytes", "Live heap bytes allocated inside the module.", &ModuleMemoryUsage::heapBytes},
+    };
+    for (const auto& gauge : memoryGauges) {
+        out += std::string("# TYPE ") + gauge.name + " gauge\n";
+        out += std::string("# HELP ") + gauge.name + " " + gauge.help + "\n";
+        for (const auto& module : snapshot.modules) {
+            out += std::string(gauge.name) + "{module=\"" + escapeLabel(module.name) + "\"} " +
+                   std::to_string(module.memory.*gauge.field) + "\n";
+        }
+    }
+
+    out += "# TYPE hotswap_module_cpu_seconds counter\n"
+           "# HELP hotswap_module_cpu_seconds CPU time spent inside module calls.\n";
+    for (const auto& module : snapshot.modules) {
+        out += "hotswap_module_cpu_seconds_total{module=\"" + escapeLabel(module.name) + "\"} " +
+               seconds(module.cpuTimeNs) + "\n";
+    }
+
+    out += "# TYPE hotswap_module_operation_duration_seconds histogram\n"
+           "# HELP hotswap_module_operation_duration_seconds Module lifecycle and health check latency.\n";
+    for (const auto& module : snapshot.modules) {
+        std::string moduleLabel = "module=\"" + escapeLabel(module.name) + "\"";
+        for (size_t op = 0; op < HealthMonitor::kLatencyOperationCount; op++) {
+            const LatencySummary& latency = module.latency[op];
+            if (latency.count == 0) {
+                continue;
+            }
+            std::string labels = moduleLabel + ",operation=\"" + kOperationNames[op] + "\"";
+            for (size_t i = 0; i < LatencySummary::kBoundCount; i++) {
+                out += "hotswap_module_operation_duration_seconds_bucket{" + labels + ",le=\"" +
+                       seconds(LatencySummary::kBoundsNs[i]) + "\"} " + std::to_string(latency.cumulative[i]) + "\n";
+            }
+            out += "hotswap_module_operation_duration_seconds_bucket{" + labels + ",le=\"+Inf\"} " +
+                   std::to_string(latency.count) + "\n";
+            out += "hotswap_module_operation_duration_seconds_count{" + labels + "} " +
+                   std::to_string(latency.count) + "\n";
+            out += "hotswap_module_operation_duration_seconds_sum{" + labels + "} " +
+                   seconds(latency.sumNs) + "\n";
+        }
+    }
+
+    out += "# EOF\n";
+    return out;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include "HealthMonitor.hpp"
+
+// Serves the HealthMonitor metrics snapshot in OpenMetrics text format over
+// HTTP on a Unix domain socket or a loopback TCP port. A scrape only renders
+// the latest published snapshot - it never takes healthMutex or moduleMutex.
+class MetricsExporter {
+public:
+    MetricsExporter();
+    ~MetricsExporter();
+
+    // Replaces a stale socket file at the path
+    bool listenUnix(const std::string& socketPath);
+    // Binds 127.0.0.1 only; port 0 picks a free port (see getPort)
+    bool listenLoopback(uint16_t port);
+    void stop();
+    bool isRunning() const;
+    uint16_t getPort() const;
+
+    static std::string render(const HealthMonitor::MetricsSnapshot& snapshot);
+
+    // Prevent copying
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+private:
+    bool startServing(int fd);
+    void serveLoop();
+    void handleClient(int clientFd);
+
+    int listenFd;
+    int wakePipe[2];
+    std::thread serverThread;
+    std::atomic<bool> running;
+    uint16_t port;
+    std::string socketPath;
+};
@@ -0,0 +1,147 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+// Layout of the POSIX shared-memory segment HealthMonitor mirrors its
+// metrics into. External tools map it read-only and sample it without any
+// syscall or cooperation from the host. Records are indexed by the stable
+// HealthMonitor module ID and each one is protected by its own seqlock.
+// Any incompatible layout change must bump kVersion.
+namespace metrics_segment {
+
+constexpr uint32_t kMagic = 0x314D5348; // "HSM1"
+constexpr uint32_t kVersion = 3;
+constexpr size_t kMaxModules = 1024;
+constexpr size_t kNameLength = 64;
+constexpr size_t kOperationCount = 4; // load, unload, hot_swap, health_check
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Segment needs address-free 64-bit atomics");
+
+struct OperationLatency {
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sumNs;
+    std::atomic<uint64_t> p50Ns;
+    std::atomic<uint64_t> p99Ns;
+    std::atomic<uint64_t> p999Ns;
+    std::atomic<uint64_t> maxNs;
+};
+
+// Name is written once, before the record is counted in moduleCount
+struct alignas(64) ModuleRecord {
+    std::atomic<uint32_t> sequence; // odd while the host is writing
+    std::atomic<uint32_t> registered;
+    std::atomic<uint32_t> status;   // HealthMonitor::HealthStatus
+    std::atomic<uint32_t> consecutiveFailures;
+    char name[kNameLength];
+    std::atomic<uint64_t> responseTimeNs;
+    std::atomic<uint64_t> totalLoads;
+    std::atomic<uint64_t> totalUnloads;
+    std::atomic<uint64_t> totalHotSwaps;
+    std::atomic<uint64_t> failedOperations;
+    std::atomic<uint64_t> mappedBytes;   // module image (PT_LOAD segments)
+    std::atomic<uint64_t> residentBytes; // of which resident
+    std::atomic<uint64_t> heapBytes;     // attributed heap, 0 unless enabled
+    std::atomic<uint64_t> cpuTimeNs;     // inside module call scopes
+    std::atomic<uint64_t> timedCalls;
+    OperationLatency latency[kOperationCount];
+};
+
+struct alignas(64) Header {
+    std::atomic<uint32_t> magic;    // stored last, once the segment is initialized
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t recordSize;
+    uint32_t capacity;
+    int32_t hostPid;
+    std::atomic<uint32_t> moduleCount;
+    std::atomic<uint32_t> systemHealth;
+    std::atomic<uint64_t> publishedAtNs; // CLOCK_REALTIME
+    std::atomic<uint64_t> publishCount;
+};
+
+struct Segment {
+    Header header;
+    ModuleRecord modules[kMaxModules];
+};
+
+// Plain copy of one record, as seen by a reader
+struct ModuleValues {
+    char name[kNameLength];
+    bool registered;
+    uint32_t status;
+    uint32_t consecutiveFailures;
+    uint64_t responseTimeNs;
+    uint64_t totalLoads;
+    uint64_t totalUnloads;
+    uint64_t totalHotSwaps;
+    uint64_t failedOperations;
+    uint64_t mappedBytes;
+    uint64_t residentBytes;
+    uint64_t heapBytes;
+    uint64_t cpuTimeNs;
+    uint64_t timedCalls;
+    struct {
+        uint64_t count, sumNs, p50Ns, p99Ns, p999Ns, maxNs;
+    } latency[kOperationCount];
+};
+
+inline std::string defaultName(pid_t pid) {
+    return "/hotswap_metrics." + std::to_string(pid);
+}
+
+// Host side: bracket field stores with beginWrite/endWrite
+inline void beginWrite(ModuleRecord& record) {
+    record.sequence.store(record.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+inline void endWrite(ModuleRecord& record) {
+    record.sequence.store(record.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+// Reader side: consistent copy, or false if the host kept writing
+inline bool readModule(const ModuleRecord& record, ModuleValues& out, int maxRetries = 100) {
+    for (int attempt = 0; attempt < maxRetries; attempt++) {
+        uint32_t before = record.sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+
+        memcpy(out.name, record.name, kNameLength);
+        out.name[kNameLength - 1] = '\0';
+        out.registered = record.registered.load(std::memory_order_relaxed) != 0;
+        out.status = record.status.load(std::memory_order_relaxed);
+        out.consecutiveFailures = record.consecutiveFailures.load(std::memory_order_relaxed);
+        out.responseTimeNs = record.responseTimeNs.load(std::memory_order_relaxed);
+        out.totalLoads = record.totalLoads.load(std::memory_order_relaxed);
+        out.totalUnloads = record.totalUnloads.load(std::memory_order_relaxed);
+        out.totalHotSwaps = record.totalHotSwaps.load(std::memory_order_relaxed);
+        out.failedOperations = record.failedOperations.load(std::memory_order_relaxed);
+        out.mappedBytes = record.mappedBytes.load(std::memory_order_relaxed);
+        out.residentBytes = record.residentBytes.load(std::memory_order_relaxed);
+        out.heapBytes = record.heapBytes.load(std::memory_order_relaxed);
+        out.cpuTimeNs = record.cpuTimeNs.load(std::memory_order_relaxed);
+        out.timedCalls = record.timedCalls.load(std::memory_order_relaxed);
+        for (size_t op = 0; op < kOperationCount; op++) {
+            const OperationLatency& latency = record.latency[op];
+            out.latency[op].count = latency.count.load(std::memory_order_relaxed);
+            out.latency[op].sumNs = latency.sumNs.load(std::memory_order_relaxed);
+            out.latency[op].p50Ns = latency.p50Ns.load(std::memory_order_relaxed);
+            out.latency[op].p99Ns = latency.p99Ns.load(std::memory_order_relaxed);
+            out.latency[op].p999Ns = latency.p999Ns.load(std::memory_order_relaxed);
+            out.latency[op].maxNs = latency.maxNs.load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (record.sequence.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace metrics_segment
@@ -0,0 +1,196 @@
+#include "ModuleCallScope.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HOTSWAP_HAVE_TSC 1
+#endif
+
+thread_local ModuleCallScope* ModuleCallScope::active = nullptr;
+
+namespace {
+
+struct alignas(64) ModuleAccount {
+    std::atomic<uint64_t> heapBytes;
+    std::atomic<uint64_t> cpuTimeNs;
+    std::atomic<uint64_t> calls;
+};
+
+// Zero-initialized before any dynamic initialization, so operator new may
+// use them from the very first allocation in the process
+ModuleAccount accounts[ModuleCallScope::kMaxModules];
+
+std::atomic<ModuleCallScope::CpuClock> activeClock{ModuleCallScope::CpuClock::THREAD_CPUTIME};
+std::atomic<double> tscTicksPerNs{0.0};
+std::atomic<uint32_t> samplingPeriod{1};
+std::atomic<uint32_t> samplingGeneration{0}; // bumped on every period change
+thread_local uint32_t scopesUntilSample = 0;
+thread_local uint32_t sampledGeneration = 0;
+
+} // namespace
+
+void ModuleCallScope::setCpuClock(CpuClock clock) {
+#ifdef HOTSWAP_HAVE_TSC
+    if (clock == CpuClock::TSC && tscTicksPerNs.load(std::memory_order_acquire) == 0.0) {
+        auto wallStart = std::chrono::steady_clock::now();
+        uint64_t tscStart = __rdtsc();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        uint64_t tscEnd = __rdtsc();
+        auto wallNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - wallStart).count();
+        tscTicksPerNs.store(static_cast<double>(tscEnd - tscStart) / static_cast<double>(wallNs),
+                            std::memory_order_release);
+    }
+#else
+    if (clock == CpuClock::TSC) {
+        clock = CpuClock::THREAD_CPUTIME;
+    }
+#endif
+    activeClock.store(clock, std::memory_order_relaxed);
+}
+
+ModuleCallScope::CpuClock ModuleCallScope::cpuClock() {
+    return activeClock.load(std::memory_order_relaxed);
+}
+
+void ModuleCallScope::setSamplingPeriod(uint32_t period) {
+    samplingPeriod.store(period ? period : 1, std::memory_order_relaxed);
+    samplingGeneration.fetch_add(1, std::memory_order_release);
+}
+
+// A timed scope is weighted by the period its countdown was started with;
+// a period change restarts every thread's countdown at its next scope
+ModuleCallScope::CpuClock ModuleCallScope::sampleClock(uint32_t& weight) {
+    uint32_t generation = samplingGeneration.load(std::memory_order_acquire);
+    if (generation != sampledGeneration) {
+        sampledGeneration = generation;
+        scopesUntilSample = 0;
+    }
+    if (scopesUntilSample > 0) {
+        scopesUntilSample--;
+        return CpuClock::OFF;
+    }
+    weight = samplingPeriod.load(std::memory_order_relaxed);
+    scopesUntilSample = weight - 1;
+    return activeClock.load(std::memory_order_relaxed);
+}
+
+uint64_t ModuleCallScope::readTicks(CpuClock clock) {
+#ifdef HOTSWAP_HAVE_TSC
+    if (clock == CpuClock::TSC) {
+        return __rdtsc();
+    }
+#endif
+    (void)clock;
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+}
+
+void ModuleCallScope::finish() {
+    uint64_t elapsed = readTicks(clock) - startTicks;
+    if (parent && parent->clock == clock) {
+        parent->childTicks += elapsed;
+    }
+    if (moduleId >= kMaxModules) {
+        return;
+    }
+
+    uint64_t selfTicks = elapsed > childTicks ? elapsed - childTicks : 0;
+    uint64_t selfNs = selfTicks;
+    if (clock == CpuClock::TSC) {
+        selfNs = static_cast<uint64_t>(static_cast<double>(selfTicks) /
+                                       tscTicksPerNs.load(std::memory_order_relaxed));
+    }
+    accounts[moduleId].cpuTimeNs.fetch_add(selfNs * weight, std::memory_order_relaxed);
+    accounts[moduleId].calls.fetch_add(weight, std::memory_order_relaxed);
+}
+
+uint64_t ModuleCallScope::cpuTimeNs(uint32_t moduleId) {
+    return moduleId < kMaxModules ? accounts[moduleId].cpuTimeNs.load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t ModuleCallScope::callCount(uint32_t moduleId) {
+    return moduleId < kMaxModules ? accounts[moduleId].calls.load(std::memory_order_relaxed) : 0;
+}
+
+#ifdef HOTSWAP_HEAP_ATTRIBUTION
+
+namespace {
+
+// Every operator new block carries its owner, so a free from any thread or
+// scope is credited back to the module that allocated it
+struct alignas(alignof(std::max_align_t)) AllocationHeader {
+    uint64_t size;
+    uint32_t moduleId;
+};
+
+void* attributedAllocate(size_t size) noexcept {
+    auto* header = static_cast<AllocationHeader*>(std::malloc(sizeof(AllocationHeader) + size));
+    if (!header) {
+        return nullptr;
+    }
+    uint32_t moduleId = ModuleCallScope::currentModule();
+    header->size = size;
+    header->moduleId = moduleId;
+    if (moduleId < ModuleCallScope::kMaxModules) {
+        accounts[moduleId].heapBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    return header + 1;
+}
+
+void attributedFree(void* pointer) noexcept {
+    if (!pointer) {
+        return;
+    }
+    auto* header = static_cast<AllocationHeader*>(pointer) - 1;
+    if (header->moduleId < ModuleCallScope::kMaxModules) {
+        accounts[header->moduleId].heapBytes.fetch_sub(header->size, std::memory_order_relaxed);
+    }
+    std::free(header);
+}
+
+void* attributedNew(size_t size) {
+    void* pointer = attributedAllocate(size ? size : 1);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+} // namespace
+
+// Aligned (std::align_val_t) forms keep the library default and stay unattributed
+void* operator new(size_t size) { return attributedNew(size); }
+void* operator new[](size_t size) { return attributedNew(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return attributedAllocate(size ? size : 1); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return attributedAllocate(size ? size : 1); }
+void operator delete(void* pointer) noexcept { attributedFree(pointer); }
+void operator delete[](void* pointer) noexcept { attributedFree(pointer); }
+void operator delete(void* pointer, size_t) noexcept { attributedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { attributedFree(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { attributedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { attributedFree(pointer); }
+
+bool ModuleCallScope::heapAttributionEnabled() {
+    return true;
+}
+
+#else
+
+bool ModuleCallScope::heapAttributionEnabled() {
+    return false;
+}
+
+#endif
+
+uint64_t ModuleCallScope::heapBytes(uint32_t moduleId) {
+    if (moduleId >= kMaxModules) {
+        return 0;
+    }
+    return accounts[moduleId].heapBytes.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Marks the calling thread as executing inside a module, identified by its
+// HealthMonitor module ID. ModuleManager wraps every lifecycle and health
+// check call; hosts can wrap their own calls into a module the same way.
+// Scopes nest - the innermost one owns whatever happens inside it.
+class ModuleCallScope {
+public:
+    static constexpr uint32_t kNoModule = 0xFFFFFFFF;
+    static constexpr size_t kMaxModules = 1024; // HealthMonitor::kMaxTrackedModules
+
+    // How CPU time spent inside scopes is measured
+    enum class CpuClock {
+        OFF,            // scopes only mark the module (heap attribution)
+        THREAD_CPUTIME, // CLOCK_THREAD_CPUTIME_ID - exact CPU time, one clock read per edge
+        TSC             // rdtsc - much cheaper, but counts wall time (incl. blocking); x86 only
+    };
+
+    explicit ModuleCallScope(uint32_t moduleId)
+        : moduleId(moduleId), parent(active), weight(parent ? parent->weight : 1),
+          clock(parent ? parent->clock : sampleClock(weight)), childTicks(0),
+          startTicks(clock != CpuClock::OFF ? readTicks(clock) : 0) {
+        active = this;
+    }
+    ~ModuleCallScope() {
+        active = parent;
+        if (clock != CpuClock::OFF) {
+            finish();
+        }
+    }
+
+    static uint32_t currentModule() { return active ? active->moduleId : kNoModule; }
+
+    // Process-wide; switching to TSC calibrates it once (~10ms), and falls
+    // back to THREAD_CPUTIME where there is no usable TSC
+    static void setCpuClock(CpuClock clock);
+    static CpuClock cpuClock();
+    // Time only every Nth outermost scope per thread and scale it up by N;
+    // nested scopes follow their outermost one. 1 = time every call.
+    static void setSamplingPeriod(uint32_t period);
+
+    // CPU time spent inside the module's scopes, excluding nested scopes of
+    // other modules, and the number of timed scopes (both scaled by sampling)
+    static uint64_t cpuTimeNs(uint32_t moduleId);
+    static uint64_t callCount(uint32_t moduleId);
+
+    // Live heap bytes allocated through operator new while inside a scope of
+    // the module, wherever they are freed. Only tracked when built with
+    // HOTSWAP_HEAP_ATTRIBUTION (replaces the global operator new/delete).
+    static bool heapAttributionEnabled();
+    static uint64_t heapBytes(uint32_t moduleId);
+
+    ModuleCallScope(const ModuleCallScope&) = delete;
+    ModuleCallScope& operator=(const ModuleCallScope&) = delete;
+
+private:
+    static uint64_t readTicks(CpuClock clock);
+    static CpuClock sampleClock(uint32_t& weight);
+    void finish();
+
+    static thread_local ModuleCallScope* active;
+
+    uint32_t moduleId;
+    ModuleCallScope* parent;
+    uint32_t weight; // sampling period this scope was timed under
+    CpuClock clock;
+    uint64_t childTicks; // time of nested scopes, charged to them instead
+    uint64_t startTicks;
+};
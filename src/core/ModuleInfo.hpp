@@ -1,15 +1,27 @@
 #pragma once
 #include <string>
 #include <chrono>
+#include <cstdint>
+
+// Memory a module costs the host process
+struct ModuleMemoryUsage {
+    uint64_t mappedBytes = 0;   // PT_LOAD segments of the module's image
+    uint64_t residentBytes = 0; // of those, pages currently in RAM (mincore)
+    uint64_t heapBytes = 0;     // live operator new bytes (HOTSWAP_HEAP_ATTRIBUTION)
+};
 
 struct ModuleInfo {
     std::string name;          
     std::string version;       
     std::string libraryPath;   
+    std::string previousLibraryPath; // version before the last swap (rollback target)
     
     
     bool isRunning = false;    
     bool isHealthy = true;    
+    bool isolated = false;     // runs in a separate worker process
+
+    ModuleMemoryUsage memory;  // filled in by ModuleManager::getModuleInfo
     
     std::chrono::system_clock::time_point loadTime; 
     
@@ -1,15 +1,26 @@
 #include "ModuleManager.hpp"
 #include "../utils/Logger.hpp"
+#include "../utils/BinaryLog.hpp"
 #include "HealthMonitor.hpp"
+#include "IsolatedModule.hpp"
+#include "ModuleCallScope.hpp"
 #include <iostream>
 #include <dlfcn.h>
-#include <fstream>
-#include <sstream>
 #include <set>
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <link.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 // Singleton instance
 ModuleManager* ModuleManager::instance = nullptr;
 
+static_assert(ModuleManager::kInvalidMetricsId == HealthMonitor::kInvalidModuleId,
+              "ModuleManager and HealthMonitor disagree on the invalid ID");
+
 // Singleton access
 ModuleManager& ModuleManager::getInstance() {
     if (!instance) {
@@ -24,7 +35,6 @@ bool ModuleManager::loadModule(const std::string& libraryPath) {
     std::lock_guard<std::mutex> lock(moduleMutex);
     
     auto& logger = Logger::getInstance();
-    auto& healthMonitor = HealthMonitor::getInstance();
     
     logger.info("Loading module: " + libraryPath, "ModuleManager");
     auto loadStartTime = std::chrono::steady_clock::now();
@@ -37,7 +47,7 @@ bool ModuleManager::loadModule(const std::string& libraryPath) {
             return false;
         }
 
-        logger.debug("Library loaded successfully: " + libraryPath, "ModuleManager");
+        HOTSWAP_LOG_DEBUG("ModuleManager", "Library loaded successfully: " + libraryPath);
 
         // Step 2: Factory functions get karo
         using CreateFunc = IModule* (*)();
@@ -49,7 +59,7 @@ bool ModuleManager::loadModule(const std::string& libraryPath) {
             return false;
         }
 
-        logger.debug("Factory functions found", "ModuleManager");
+        HOTSWAP_LOG_DEBUG("ModuleManager", "Factory functions found");
 
         // Step 3: Module create karo
         IModule* module = createModule();
@@ -58,77 +68,163 @@ bool ModuleManager::loadModule(const std::string& libraryPath) {
             return false;
         }
 
-        // Step 4: Module initialize karo
-        if (!module->init()) {
+        // Step 4: Module initialize karo (module ke naam pe attribute karke)
+        bool initialized;
+        {
+            ModuleCallScope scope(HealthMonitor::getInstance().getModuleId(module->getName()));
+            initialized = module->init();
+            if (!initialized) {
+                destroyModule(module);
+            }
+        }
+        if (!initialized) {
             logger.error("Module initialization failed: " + libraryPath, "ModuleManager");
-            destroyModule(module);
             return false;
         }
 
-        // Step 5: ModuleInfo setup karo
-        ModuleInfo info;
-        info.name = module->getName();
-        info.version = module->getVersion();
-        info.libraryPath = libraryPath;
-        info.loadTime = std::chrono::system_clock::now();
-
-        // Step 6: ModuleHandle create karo
+        // Step 5: ModuleHandle create karo
         ModuleHandle handle;
         handle.library = std::move(library);
         handle.module = module;
-        handle.info = info;
+        handle.info.libraryPath = libraryPath;
         handle.markedForUnload = false;
 
-        // Custom deleter with destroy function
-        struct ModuleDeleter {
-            void (*destroy)(IModule*);
-            ModuleDeleter(void (*d)(IModule*)) : destroy(d) {}
-            void operator()(IModule* mod) const {
-                if (mod && destroy) {
-                    mod->stop();
-                    mod->cleanup();
-                    destroy(mod);
-                }
-            }
-        };
+        return activateModule(std::move(handle), loadStartTime);
 
-        // Step 7: Map mein store karo
-        modules[info.name] = std::move(handle);
+    } catch (const std::exception& e) {
+        logger.error("Exception in loadModule: " + std::string(e.what()), "ModuleManager");
+        return false;
+    }
+}
 
-        // Step 8: Module start karo
-        module->start();
-        modules[info.name].info.isRunning = true;
-        modules[info.name].info.isHealthy = true;
+// Isolated load - module runs in its own worker process
+bool ModuleManager::loadModuleIsolated(const std::string& libraryPath) {
+    std::lock_guard<std::mutex> lock(moduleMutex);
 
-        // Register with health monitor - FIXED LAMBDA
-        auto healthCheckFunction = [this, moduleName = info.name]() -> bool {
-            auto* modulePtr = this->getModule(moduleName);
-            return modulePtr ? modulePtr->isHealthy() : false;
-        };
-        healthMonitor.registerModule(info.name, healthCheckFunction);
+    auto& logger = Logger::getInstance();
 
-        // Record metrics
-        auto loadEndTime = std::chrono::steady_clock::now();
-        auto loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(loadEndTime - loadStartTime);
-        healthMonitor.recordModuleLoad(info.name, loadTime);
+    logger.info("Loading isolated module: " + libraryPath, "ModuleManager");
+    auto loadStartTime = std::chrono::steady_clock::now();
 
-        logger.info("Module loaded successfully: " + info.name + " v" + info.version + 
-                   " (load time: " + std::to_string(loadTime.count()) + "ms)", "ModuleManager");
-        return true;
+    try {
+        // Step 1: Worker process spawn karo (worker khud dlopen karega)
+        auto module = std::make_unique<IsolatedModule>(libraryPath, resolveWorkerExecutable());
+        if (!module->launch()) {
+            logger.error("Failed to launch module worker for: " + libraryPath, "ModuleManager");
+            return false;
+        }
+
+        // Step 2: Module initialize karo
+        if (!module->init()) {
+            logger.error("Isolated module initialization failed: " + libraryPath, "ModuleManager");
+            return false;
+        }
+
+        ModuleHandle handle;
+        handle.module = module.release();
+        handle.info.libraryPath = libraryPath;
+        handle.info.isolated = true;
+        handle.markedForUnload = false;
+
+        return activateModule(std::move(handle), loadStartTime);
 
     } catch (const std::exception& e) {
-        logger.error("Exception in loadModule: " + std::string(e.what()), "ModuleManager");
+        logger.error("Exception in loadModuleIsolated: " + std::string(e.what()), "ModuleManager");
         return false;
     }
 }
 
+// Helper: initialized module ko register, start aur health monitor se link karna
+bool ModuleManager::activateModule(ModuleHandle handle,
+                                   std::chrono::steady_clock::time_point loadStartTime) {
+    auto& healthMonitor = HealthMonitor::getInstance();
+
+    IModule* module = handle.module;
+
+    // ModuleInfo setup karo
+    ModuleInfo& info = handle.info;
+    info.name = module->getName();
+    info.version = module->getVersion();
+    info.loadTime = std::chrono::system_clock::now();
+
+    // Map mein store karo
+    std::string moduleName = info.name;
+    handle.metricsId = healthMonitor.getModuleId(moduleName);
+    HealthMonitor::ModuleId metricsId = handle.metricsId;
+    modules[moduleName] = std::move(handle);
+
+    // Module start karo
+    {
+        ModuleCallScope scope(metricsId);
+        module->start();
+    }
+    modules[moduleName].info.isRunning = true;
+    modules[moduleName].info.isHealthy = true;
+
+    // Register with health monitor - heartbeat slot agar module push karta hai,
+    // warna polled isHealthy() check
+    HeartbeatSlot* heartbeat = healthMonitor.registerHeartbeatModule(moduleName);
+    if (!heartbeat || !module->attachHeartbeat(heartbeat)) {
+        auto fence = std::make_shared<CheckFence>();
+        modules[moduleName].checkFence = fence;
+        auto healthCheckFunction = [fence, module, metricsId]() -> bool {
+            if (!fence->enter()) {
+                return true; // jaan-boojh kar band ho raha hai - failure nahi
+            }
+            struct Leave {
+                CheckFence& fence;
+                ~Leave() { fence.leave(); }
+            } leave{*fence};
+            ModuleCallScope scope(metricsId);
+            return module->isHealthy();
+        };
+        healthMonitor.registerModule(moduleName, healthCheckFunction);
+    }
+
+    // Record metrics
+    auto loadTime = std::chrono::steady_clock::now() - loadStartTime;
+    healthMonitor.recordModuleLoad(metricsId, loadTime);
+
+    // Binary log khula ho to deferred-format record, warna wahi key=value
+    // text line - pipeline ko dono mein same keys milti hain
+    const ModuleInfo& stored = modules[moduleName].info;
+    HOTSWAP_LOG_FMT(Logger::Level::INFO, "ModuleManager",
+                    "Module loaded successfully module={} version={} isolated={} load_time_ns={} status={}",
+                    stored.name, stored.version, stored.isolated,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(loadTime).count(), "running");
+    return true;
+}
+
+void ModuleManager::setWorkerExecutable(const std::string& path) {
+    std::lock_guard<std::mutex> lock(moduleMutex);
+    workerExecutable = path;
+}
+
+// Default worker: module_worker next to the running executable
+std::string ModuleManager::resolveWorkerExecutable() const {
+    if (!workerExecutable.empty()) {
+        return workerExecutable;
+    }
+
+    char exePath[PATH_MAX];
+    ssize_t len = readlink("/proc/self/exe", exePath, sizeof(exePath) - 1);
+    if (len <= 0) {
+        return "./module_worker";
+    }
+    exePath[len] = '\0';
+    std::string dir(exePath);
+    return dir.substr(0, dir.find_last_of('/')) + "/module_worker";
+}
+
 bool ModuleManager::unloadModule(const std::string& moduleName) {
     std::lock_guard<std::mutex> lock(moduleMutex);
+    waitForRestart(moduleName);
     
     auto& logger = Logger::getInstance();
     auto& healthMonitor = HealthMonitor::getInstance();
     
     logger.info("Unloading module: " + moduleName, "ModuleManager");
+    auto unloadStartTime = std::chrono::steady_clock::now();
 
     auto it = modules.find(moduleName);
     if (it == modules.end()) {
@@ -138,27 +234,32 @@ bool ModuleManager::unloadModule(const std::string& moduleName) {
 
     try {
         ModuleHandle& handle = it->second;
+        HealthMonitor::ModuleId metricsId = handle.metricsId;
         
-        // Step 1: Module stop karo
+        // Step 1: Health monitor se hatao, phir module stop karo - stop() ka
+        // aakhri heartbeat ab kisi slot mein nahi jaata
+        quiesceModule(handle);
+        healthMonitor.unregisterModule(moduleName);
         if (handle.module) {
+            ModuleCallScope scope(metricsId);
             handle.module->stop();
             handle.info.isRunning = false;
-            logger.debug("Module stopped: " + moduleName, "ModuleManager");
+            HOTSWAP_LOG_DEBUG("ModuleManager", "Module stopped: " + moduleName);
         }
 
-        // Unregister from health monitor
-        healthMonitor.unregisterModule(moduleName);
-        
-        // Record metrics
-        healthMonitor.recordModuleUnload(moduleName);
-
         // Step 2: Cleanup karo
         cleanupModuleResources(handle);
 
         // Step 3: Map se remove karo
         modules.erase(it);
-        
-        logger.info("Module unloaded successfully: " + moduleName, "ModuleManager");
+
+        // Record metrics
+        auto unloadTime = std::chrono::steady_clock::now() - unloadStartTime;
+        healthMonitor.recordModuleUnload(metricsId, unloadTime);
+
+        HOTSWAP_LOG_FMT(Logger::Level::INFO, "ModuleManager",
+                        "Module unloaded successfully module={} unload_time_ns={} status={}", moduleName,
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(unloadTime).count(), "unloaded");
         return true;
 
     } catch (const std::exception& e) {
@@ -167,11 +268,65 @@ bool ModuleManager::unloadModule(const std::string& moduleName) {
     }
 }
 
+bool ModuleManager::CheckFence::enter() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (closed) {
+        return false;
+    }
+    inFlight++;
+    return true;
+}
+
+void ModuleManager::CheckFence::leave() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (--inFlight == 0) {
+        idle.notify_all();
+    }
+}
+
+bool ModuleManager::CheckFence::close(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex);
+    closed = true;
+    return idle.wait_for(lock, timeout, [this]() { return inFlight == 0; });
+}
+
+void ModuleManager::CheckFence::reopen() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = false;
+}
+
+// Helper: teardown se pehle polled check ko andar aane se roko aur heartbeat
+// slot chhuda do, taaki stop() ka UNHEALTHY publish na ho. Agar check module
+// code mein atka hai to module aur library chhod do (leak) - unke neeche se
+// memory/code hatana crash hoga
+void ModuleManager::quiesceModule(ModuleHandle& handle) {
+    if (!handle.checkFence || handle.checkFence->close(kCheckDrainTimeout)) {
+        if (handle.module) {
+            ModuleCallScope scope(handle.metricsId);
+            handle.module->attachHeartbeat(nullptr); // slot ab kisi aur ko mil sakta hai
+        }
+        return;
+    }
+    Logger::getInstance().error("Health check still running in " + handle.info.name +
+                                " - leaving the module loaded instead of freeing it under the check",
+                                "ModuleManager");
+    handle.module = nullptr;
+    (void)handle.library.release(); // jaan-boojh kar leak
+}
+
 // Helper: Module resources cleanup
 void ModuleManager::cleanupModuleResources(ModuleHandle& handle) {
     if (handle.module) {
+        ModuleCallScope scope(handle.metricsId);
         handle.module->cleanup();
         
+        // Isolated module: proxy delete karne se worker shutdown hota hai
+        if (!handle.library) {
+            delete handle.module;
+            handle.module = nullptr;
+            return;
+        }
+
         // Factory destroy function use karo
         using DestroyFunc = void (*)(IModule*);
         auto destroyModule = (DestroyFunc)handle.library->getFunction("destroyModule");
@@ -216,7 +371,9 @@ ModuleInfo ModuleManager::getModuleInfo(const std::string& moduleName) {
     
     auto it = modules.find(moduleName);
     if (it != modules.end()) {
-        return it->second.info;
+        ModuleInfo info = it->second.info;
+        info.memory = measureModuleMemory(it->second);
+        return info;
     }
     
     // Return empty info if not found
@@ -249,12 +406,145 @@ size_t ModuleManager::getModuleCount() const {
 
 // MOST IMPORTANT: HOT-SWAP FUNCTION
 bool ModuleManager::reloadModule(const std::string& moduleName) {
+    return hotSwap(moduleName, "");
+}
+
+bool ModuleManager::swapModule(const std::string& moduleName, const std::string& newLibraryPath) {
+    return hotSwap(moduleName, newLibraryPath);
+}
+
+bool ModuleManager::rollbackModule(const std::string& moduleName) {
+    // Target padhna aur swap shuru karna ek hi lock mein - beech mein koi
+    // aur swap target badal na de
     std::lock_guard<std::mutex> lock(moduleMutex);
-    
+    waitForRestart(moduleName);
+    auto it = modules.find(moduleName);
+    if (it == modules.end()) {
+        Logger::getInstance().error("Module not found for rollback: " + moduleName, "ModuleManager");
+        return false;
+    }
+    std::string previousPath = it->second.info.previousLibraryPath;
+
+    if (previousPath.empty()) {
+        Logger::getInstance().error("No previous version to roll back to: " + moduleName, "ModuleManager");
+        return false;
+    }
+    Logger::getInstance().info("Rolling back " + moduleName + " to " + previousPath, "ModuleManager");
+    return hotSwapLocked(moduleName, previousPath);
+}
+
+bool ModuleManager::restartModule(const std::string& moduleName) {
+    auto& logger = Logger::getInstance();
+    IModule* module;
+    std::shared_ptr<CheckFence> fence;
+    HealthMonitor::ModuleId metricsId;
+    {
+        std::lock_guard<std::mutex> lock(moduleMutex);
+        auto it = modules.find(moduleName);
+        if (it == modules.end() || !it->second.module) {
+            logger.error("Module not found for restart: " + moduleName, "ModuleManager");
+            return false;
+        }
+        if (it->second.restarting) {
+            logger.warning("Module restart already in progress: " + moduleName, "ModuleManager");
+            return false;
+        }
+        // Handle restarting mark karo - unload/hot-swap isko free nahi karenge,
+        // baaki sab (getModule, checks, doosre modules) chalte rahenge
+        it->second.restarting = true;
+        module = it->second.module;
+        fence = it->second.checkFence;
+        metricsId = it->second.metricsId;
+    }
+
+    // Same library, same instance - sirf lifecycle dobara chalao, lock ke
+    // bahar. Restart ke dauraan polled check andar nahi aata
+    bool stopped = false;
+    bool restarted = false;
+    if (fence && !fence->close(kCheckDrainTimeout)) {
+        logger.error("Module restart skipped, health check still running: " + moduleName, "ModuleManager");
+    } else {
+        try {
+            ModuleCallScope scope(metricsId);
+            module->stop();
+            stopped = true;
+            module->cleanup();
+            restarted = module->init() && module->start();
+        } catch (const std::exception& e) {
+            logger.error("Exception in restartModule: " + std::string(e.what()), "ModuleManager");
+        }
+    }
+    if (fence) {
+        fence->reopen();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(moduleMutex);
+        ModuleHandle& handle = modules.find(moduleName)->second; // restarting handle erase nahi hota
+        handle.restarting = false;
+        if (stopped) {
+            handle.info.isRunning = restarted;
+        }
+        if (restarted) {
+            handle.info.isHealthy = true;
+        }
+    }
+    restartDone.notify_all();
+
+    if (!stopped) {
+        return false;
+    }
+    if (!restarted) {
+        logger.error("Module restart failed: " + moduleName, "ModuleManager");
+        return false;
+    }
+    logger.info("Module restarted: " + moduleName, "ModuleManager");
+    return true;
+}
+
+// Helper: module ka restart chal raha ho to uske khatam hone tak ruko
+void ModuleManager::waitForRestart(const std::string& moduleName) {
+    restartDone.wait(moduleMutex, [this, &moduleName]() {
+        auto it = modules.find(moduleName);
+        return it == modules.end() || !it->second.restarting;
+    });
+}
+
+void ModuleManager::enableAutoRemediation(bool enabled) {
+    auto& healthMonitor = HealthMonitor::getInstance();
+    if (!enabled) {
+        healthMonitor.setRemediationHandler(nullptr);
+        return;
+    }
+
+    healthMonitor.setRemediationHandler(
+        [this](const std::string& moduleName, HealthMonitor::RemediationAction action) {
+            switch (action) {
+                case HealthMonitor::RemediationAction::RESTART_INSTANCE:
+                    return restartModule(moduleName);
+                case HealthMonitor::RemediationAction::RELOAD_LIBRARY:
+                    return reloadModule(moduleName);
+                case HealthMonitor::RemediationAction::ROLLBACK:
+                    return rollbackModule(moduleName);
+            }
+            return false;
+        });
+}
+
+// Hot-swap helper - empty newLibraryPath matlab same library reload
+bool ModuleManager::hotSwap(const std::string& moduleName, const std::string& newLibraryPath) {
+    std::lock_guard<std::mutex> lock(moduleMutex);
+    return hotSwapLocked(moduleName, newLibraryPath);
+}
+
+// Caller moduleMutex pakde rahe; library load ke dauraan yeh use kuch der chhodta hai
+bool ModuleManager::hotSwapLocked(const std::string& moduleName, const std::string& newLibraryPath) {
+    waitForRestart(moduleName);
     auto& logger = Logger::getInstance();
     auto& healthMonitor = HealthMonitor::getInstance();
     
     logger.info("Hot-swap started for module: " + moduleName, "ModuleManager");
+    auto swapStartTime = std::chrono::steady_clock::now();
 
     auto it = modules.find(moduleName);
     if (it == modules.end()) {
@@ -262,41 +552,68 @@ bool ModuleManager::reloadModule(const std::string& moduleName) {
         return false;
     }
 
-    std::string libraryPath = it->second.info.libraryPath;
+    std::string oldLibraryPath = it->second.info.libraryPath;
+    std::string libraryPath = newLibraryPath.empty() ? oldLibraryPath : newLibraryPath;
+    // Version change pe purana path rollback target banta hai
+    std::string oldPreviousLibraryPath = it->second.info.previousLibraryPath;
+    std::string previousLibraryPath = libraryPath != oldLibraryPath ? oldLibraryPath : oldPreviousLibraryPath;
+    bool isolated = it->second.info.isolated;
+    HealthMonitor::ModuleId metricsId = it->second.metricsId;
     
     try {
         // Step 1: Old module unload karo
-        logger.debug("Unloading old module: " + moduleName, "ModuleManager");
+        HOTSWAP_LOG_DEBUG("ModuleManager", "Unloading old module: " + moduleName);
         ModuleHandle oldHandle = std::move(it->second);
         modules.erase(it);
         
+        quiesceModule(oldHandle);
         if (oldHandle.module) {
+            ModuleCallScope scope(metricsId);
             oldHandle.module->stop();
             oldHandle.info.isRunning = false;
             cleanupModuleResources(oldHandle);
         }
         
         // Step 2: New module load karo
-        logger.debug("Loading new module: " + libraryPath, "ModuleManager");
+        HOTSWAP_LOG_DEBUG("ModuleManager", "Loading new module: " + libraryPath);
         bool loadSuccess = false;
+        bool restored = false;
         
         // Temporary mutex unlock for loading
         moduleMutex.unlock();
-        loadSuccess = loadModule(libraryPath);
+        loadSuccess = isolated ? loadModuleIsolated(libraryPath) : loadModule(libraryPath);
+        if (!loadSuccess && libraryPath != oldLibraryPath) {
+            // Naya version load nahi hua - purana wapas lao
+            logger.warning("Restoring previous library after failed swap: " + oldLibraryPath, "ModuleManager");
+            restored = isolated ? loadModuleIsolated(oldLibraryPath) : loadModule(oldLibraryPath);
+            if (!restored) {
+                logger.error("Failed to restore previous library: " + oldLibraryPath, "ModuleManager");
+            }
+        }
         moduleMutex.lock();
         
         if (!loadSuccess) {
+            // Restored module ka rollback target wahi rehna chahiye
+            auto restoredIt = modules.find(moduleName);
+            if (restored && restoredIt != modules.end()) {
+                restoredIt->second.info.previousLibraryPath = oldPreviousLibraryPath;
+            }
             logger.error("Hot-swap failed: Failed to load new module", "ModuleManager");
-            healthMonitor.recordHotSwap(moduleName, false);
+            healthMonitor.recordHotSwap(metricsId, false, std::chrono::steady_clock::now() - swapStartTime);
             return false;
         }
+
+        auto newIt = modules.find(moduleName);
+        if (newIt != modules.end()) {
+            newIt->second.info.previousLibraryPath = previousLibraryPath;
+        }
         
-        healthMonitor.recordHotSwap(moduleName, true);
+        healthMonitor.recordHotSwap(metricsId, true, std::chrono::steady_clock::now() - swapStartTime);
         logger.info("Hot-swap successful: " + moduleName, "ModuleManager");
         return true;
         
     } catch (const std::exception& e) {
-        healthMonitor.recordHotSwap(moduleName, false);
+        healthMonitor.recordHotSwap(metricsId, false, std::chrono::steady_clock::now() - swapStartTime);
         logger.error("Hot-swap exception: " + std::string(e.what()), "ModuleManager");
         return false;
     }
@@ -329,6 +646,14 @@ void ModuleManager::printAllModules() const {
 
 void ModuleManager::shutdown() {
     std::lock_guard<std::mutex> lock(moduleMutex);
+    restartDone.wait(moduleMutex, [this]() {
+        for (const auto& pair : modules) {
+            if (pair.second.restarting) {
+                return false;
+            }
+        }
+        return true;
+    });
     
     auto& logger = Logger::getInstance();
     logger.info("System shutdown started. Unloading " + std::to_string(modules.size()) + " modules", "ModuleManager");
@@ -336,8 +661,10 @@ void ModuleManager::shutdown() {
     for (auto& pair : modules) {
         ModuleHandle& handle = pair.second;
         
+        quiesceModule(handle);
         if (handle.module) {
-            logger.debug("Stopping module: " + handle.info.name, "ModuleManager");
+            HOTSWAP_LOG_DEBUG("ModuleManager", "Stopping module: " + handle.info.name);
+            ModuleCallScope scope(handle.metricsId);
             handle.module->stop();
             handle.info.isRunning = false;
             cleanupModuleResources(handle);
@@ -346,56 +673,171 @@ void ModuleManager::shutdown() {
     
     modules.clear();
     logger.info("System shutdown completed", "ModuleManager");
+    logger.flush();
 }
 
-void ModuleManager::scanAndLogRuntimeSharedLibraries() const {
-    auto& logger = Logger::getInstance();
+namespace {
 
-    std::set<std::string> runtimeLibs;
-    std::ifstream maps("/proc/self/maps");
-    if (!maps.is_open()) {
-        logger.warning("Unable to open /proc/self/maps to scan runtime libraries", "ModuleManager");
-        return;
+struct ImageQuery {
+    uintptr_t base;
+    const char* name;
+    ModuleMemoryUsage* usage;
+};
+
+// PT_LOAD segments of the object loaded at query->base, and how much of them is resident
+int measureLoadedImage(struct dl_phdr_info* info, size_t, void* data) {
+    auto* query = static_cast<ImageQuery*>(data);
+    if (info->dlpi_addr != query->base || !info->dlpi_name || std::strcmp(info->dlpi_name, query->name) != 0) {
+        return 0;
     }
 
-    std::string line;
-    while (std::getline(maps, line)) {
-        // Last token (if present) is the mapped path
-        std::istringstream iss(line);
-        std::string addr, perms, offset, dev, inode, path;
-        if (!(iss >> addr >> perms >> offset >> dev >> inode)) {
+    const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    std::vector<unsigned char> pages;
+    for (int i = 0; i < info->dlpi_phnum; i++) {
+        const auto& segment = info->dlpi_phdr[i];
+        if (segment.p_type != PT_LOAD || segment.p_memsz == 0) {
             continue;
         }
-        if (!(iss >> path)) {
-            continue;
-        }
-        // Only keep real file-backed shared objects
-        if (path.size() > 3 && path.find(".so") != std::string::npos) {
-            runtimeLibs.insert(path);
+        uintptr_t start = (info->dlpi_addr + segment.p_vaddr) & ~(pageSize - 1);
+        uintptr_t end = (info->dlpi_addr + segment.p_vaddr + segment.p_memsz + pageSize - 1) & ~(pageSize - 1);
+        query->usage->mappedBytes += end - start;
+
+        pages.resize((end - start) / pageSize);
+        if (mincore(reinterpret_cast<void*>(start), end - start, pages.data()) == 0) {
+            for (unsigned char page : pages) {
+                if (page & 1) {
+                    query->usage->residentBytes += pageSize;
+                }
+            }
         }
     }
-    maps.close();
+    return 1;
+}
+
+} // namespace
+
+// Caller must hold moduleMutex. Isolated modules live in their worker's address space
+ModuleMemoryUsage ModuleManager::measureModuleMemory(const ModuleHandle& handle) {
+    ModuleMemoryUsage usage;
+    usage.heapBytes = ModuleCallScope::heapBytes(handle.metricsId);
+
+    struct link_map* linkMap = nullptr;
+    if (handle.library && handle.library->getHandle() &&
+        dlinfo(handle.library->getHandle(), RTLD_DI_LINKMAP, &linkMap) == 0 && linkMap) {
+        ImageQuery query{static_cast<uintptr_t>(linkMap->l_addr), linkMap->l_name, &usage};
+        dl_iterate_phdr(measureLoadedImage, &query);
+    }
+    return usage;
+}
+
+ModuleMemoryUsage ModuleManager::getModuleMemoryUsage(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(moduleMutex);
+    auto it = modules.find(name);
+    return it != modules.end() ? measureModuleMemory(it->second) : ModuleMemoryUsage{};
+}
+
+std::vector<std::pair<uint32_t, ModuleMemoryUsage>> ModuleManager::sampleModuleMemory() const {
+    std::lock_guard<std::mutex> lock(moduleMutex);
+    std::vector<std::pair<uint32_t, ModuleMemoryUsage>> samples;
+    samples.reserve(modules.size());
+    for (const auto& pair : modules) {
+        samples.emplace_back(pair.second.metricsId, measureModuleMemory(pair.second));
+    }
+    return samples;
+}
+
+namespace {
+
+struct LoaderCounters {
+    unsigned long long adds = 0;
+    unsigned long long subs = 0;
+    bool available = false;
+};
+
+// Every entry carries the same global counters - first one is enough
+int readLoaderCounters(struct dl_phdr_info* info, size_t size, void* data) {
+    auto* counters = static_cast<LoaderCounters*>(data);
+    if (size >= offsetof(struct dl_phdr_info, dlpi_subs) + sizeof(info->dlpi_subs)) {
+        counters->adds = info->dlpi_adds;
+        counters->subs = info->dlpi_subs;
+        counters->available = true;
+    }
+    return 1;
+}
+
+// Canonical path, so "./calculator_v1.so" and the loader's name compare equal
+std::string canonicalLibraryPath(const std::string& path) {
+    char resolved[PATH_MAX];
+    return realpath(path.c_str(), resolved) ? std::string(resolved) : path;
+}
+
+int collectLoadedObject(struct dl_phdr_info* info, size_t, void* data) {
+    auto* libraries = static_cast<std::set<std::string>*>(data);
+    // Main program has an empty name, the vDSO has no path
+    if (info->dlpi_name && std::strchr(info->dlpi_name, '/')) {
+        libraries->insert(canonicalLibraryPath(info->dlpi_name));
+    }
+    return 0;
+}
+
+} // namespace
+
+void ModuleManager::scanAndLogRuntimeSharedLibraries() const {
+    std::lock_guard<std::mutex> scanLock(libraryScanMutex);
 
-    // Snapshot managed module library paths
+    LoaderCounters counters;
+    dl_iterate_phdr(readLoaderCounters, &counters);
+    if (libraryScanDone && counters.available &&
+        counters.adds == libraryAdds && counters.subs == librarySubs) {
+        return; // Kuch load/unload nahi hua
+    }
+
+    auto& logger = Logger::getInstance();
+    std::set<std::string> currentLibs;
+    dl_iterate_phdr(collectLoadedObject, &currentLibs);
+
+    // Snapshot managed module library paths (isolated modules live in worker processes)
     std::set<std::string> managedPaths;
     {
         std::lock_guard<std::mutex> lock(moduleMutex);
         for (const auto& pair : modules) {
-            managedPaths.insert(pair.second.info.libraryPath);
+            if (pair.second.library) {
+                managedPaths.insert(canonicalLibraryPath(pair.second.info.libraryPath));
+            }
         }
     }
 
-    logger.info("Runtime shared library scan: found " + std::to_string(runtimeLibs.size()) + " .so mappings", "ModuleManager");
-
-    for (const auto& lib : runtimeLibs) {
-        bool managed = managedPaths.find(lib) != managedPaths.end();
-        logger.info(std::string(managed ? "[MANAGED] " : "[UNMANAGED] ") + lib, "ModuleManager");
+    size_t added = 0;
+    size_t removed = 0;
+    for (const auto& lib : currentLibs) {
+        if (runtimeLibraries.find(lib) == runtimeLibraries.end()) {
+            bool managed = managedPaths.find(lib) != managedPaths.end();
+            // Ek line per object - hundreds of modules se flood na ho isliye rate limited
+            HOTSWAP_LOG_LIMITED(Logger::Level::INFO, "ModuleManager", 20, 100,
+                                std::string(managed ? "[MANAGED] " : "[UNMANAGED] ") + "loaded " + lib);
+            added++;
+        }
+    }
+    for (const auto& lib : runtimeLibraries) {
+        if (currentLibs.find(lib) == currentLibs.end()) {
+            HOTSWAP_LOG_LIMITED(Logger::Level::INFO, "ModuleManager", 20, 100, "Unloaded " + lib);
+            removed++;
+        }
+    }
+    if (added > 0 || removed > 0) {
+        logger.info("Runtime shared library scan: " + std::to_string(currentLibs.size()) + " objects (+" +
+                    std::to_string(added) + " -" + std::to_string(removed) + ")", "ModuleManager");
     }
 
-    // Optionally: log managed modules that are not present in runtime libs
     for (const auto& mp : managedPaths) {
-        if (runtimeLibs.find(mp) == runtimeLibs.end()) {
-            logger.warning("Managed module library not present in runtime maps: " + mp, "ModuleManager");
+        if (currentLibs.find(mp) == currentLibs.end()) {
+            HOTSWAP_LOG_LIMITED(Logger::Level::WARNING, "ModuleManager", 5, 20,
+                                "Managed module library not present in loaded objects: " + mp);
         }
     }
-}
\ No newline at end of file
+
+    runtimeLibraries.swap(currentLibs);
+    libraryAdds = counters.adds;
+    librarySubs = counters.subs;
+    libraryScanDone = true;
+}
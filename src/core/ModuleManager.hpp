@@ -1,17 +1,48 @@
 #pragma once
 #include <string>
 #include <map>
+#include <set>
 #include <memory>
 #include <mutex>
+#include <condition_variable>
 #include <vector>
+#include <utility>
+#include <chrono>
+#include <cstdint>
 #include "IModule.hpp"
 #include "ModuleInfo.hpp"
 #include "DynamicLibrary.hpp"
 
 class ModuleManager {
+public:
+    // HealthMonitor::kInvalidModuleId - metrics ID abhi assign nahi hua
+    static constexpr uint32_t kInvalidMetricsId = 0xFFFFFFFF;
+
 private:
     static ModuleManager* instance;
     mutable std::mutex moduleMutex; // Thread safety ke liye
+    // Restart module code ko moduleMutex ke bahar chalata hai; teardown
+    // (unload/hot-swap/shutdown) tab tak yahan rukta hai
+    std::condition_variable_any restartDone;
+
+    // Polled health check pool thread par module code chalata hai, bina
+    // moduleMutex ke. Teardown se pehle fence band hota hai aur chal raha
+    // check khatam hone tak wait hota hai - module/library uske neeche se
+    // free nahi hoti.
+    class CheckFence {
+    public:
+        bool enter();                               // false once closed
+        void leave();
+        bool close(std::chrono::milliseconds timeout); // false if a check is still inside
+        void reopen();
+    private:
+        std::mutex mutex;
+        std::condition_variable idle;
+        int inFlight = 0;
+        bool closed = false;
+    };
+    // Hung check ka itna wait, phir module jaan-boojh kar leak hota hai
+    static constexpr std::chrono::milliseconds kCheckDrainTimeout{5000};
 
     // Module storage structure - jaise phone mein app info
     struct ModuleHandle {
@@ -19,9 +50,20 @@ private:
         IModule* module;                         // Module object
         ModuleInfo info;                         // Module information
         bool markedForUnload;                    // Safe unload ke liye
+        uint32_t metricsId = kInvalidMetricsId;  // HealthMonitor metrics ID (cached)
+        std::shared_ptr<CheckFence> checkFence;  // Polled modules only
+        bool restarting = false;                 // restartModule lock ke bahar chal raha hai
     };
 
     std::map<std::string, ModuleHandle> modules; // All modules store here
+    std::string workerExecutable;                // Isolated modules ka worker binary
+
+    // Runtime library scan state - dl_iterate_phdr counters aur pichla snapshot
+    mutable std::mutex libraryScanMutex;
+    mutable bool libraryScanDone = false;
+    mutable unsigned long long libraryAdds = 0;
+    mutable unsigned long long librarySubs = 0;
+    mutable std::set<std::string> runtimeLibraries;
 
     // Private constructor - Singleton pattern
     ModuleManager() = default;
@@ -30,6 +72,13 @@ private:
     // Helper functions
     bool safeModuleUnload(ModuleHandle& handle);
     void cleanupModuleResources(ModuleHandle& handle);
+    void quiesceModule(ModuleHandle& handle);
+    void waitForRestart(const std::string& moduleName); // caller holds moduleMutex
+    bool activateModule(ModuleHandle handle, std::chrono::steady_clock::time_point loadStartTime);
+    std::string resolveWorkerExecutable() const;
+    bool hotSwap(const std::string& moduleName, const std::string& newLibraryPath);
+    bool hotSwapLocked(const std::string& moduleName, const std::string& newLibraryPath);
+    static ModuleMemoryUsage measureModuleMemory(const ModuleHandle& handle);
 
 public:
     // Singleton pattern - prevent copying
@@ -44,11 +93,26 @@ public:
     // 1. Module load karna
     bool loadModule(const std::string& libraryPath);
     
+    // 1b. Module ko alag worker process mein load karna (crash isolation)
+    bool loadModuleIsolated(const std::string& libraryPath);
+    
     // 2. Module unload karna  
     bool unloadModule(const std::string& moduleName);
     
     // 3. Module reload karna (Hot-swap!)
     bool reloadModule(const std::string& moduleName);
+
+    // 3b. Naye version ki library pe hot-swap (purana path rollback ke liye yaad rehta hai)
+    bool swapModule(const std::string& moduleName, const std::string& newLibraryPath);
+
+    // 3c. Pichle version pe wapas jana
+    bool rollbackModule(const std::string& moduleName);
+
+    // 3d. Library reload kiye bina instance restart (stop/cleanup/init/start)
+    bool restartModule(const std::string& moduleName);
+
+    // 3e. CRITICAL modules ko HealthMonitor khud restart/reload/rollback kare
+    void enableAutoRemediation(bool enabled = true);
     
     // 4. Module access karna
     IModule* getModule(const std::string& name);
@@ -56,6 +120,12 @@ public:
     // 5. Module information
     ModuleInfo getModuleInfo(const std::string& name);
     
+    // 5b. Module kitni memory kha raha hai (image mapped/resident + attributed heap)
+    ModuleMemoryUsage getModuleMemoryUsage(const std::string& name) const;
+
+    // 5c. Sab loaded modules ka memory sample, HealthMonitor metrics ID ke saath
+    std::vector<std::pair<uint32_t, ModuleMemoryUsage>> sampleModuleMemory() const;
+    
     // 6. All modules list karna
     std::vector<std::string> getAllModuleNames() const;
     
@@ -71,7 +141,10 @@ public:
     // 10. Get loaded modules count
     size_t getModuleCount() const;
 
-    // Scan /proc/self/maps for loaded .so files and log them.
-    // Compares runtime shared libs to modules managed by ModuleManager.
+    // Worker executable for isolated modules (default: module_worker next to the host binary)
+    void setWorkerExecutable(const std::string& path);
+
+    // Loaded shared objects (dl_iterate_phdr) ko managed modules se compare karke log karna.
+    // Sirf tab scan hota hai jab loader ke adds/subs counters badle; sirf differences log hote hain.
     void scanAndLogRuntimeSharedLibraries() const;
 };
\ No newline at end of file
@@ -0,0 +1,106 @@
+// Module worker process - hosts a single module .so for IsolatedModule.
+// Usage: module_worker <library-path> <channel-fd>
+
+#include <iostream>
+#include <string>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <dlfcn.h>
+#include <sys/mman.h>
+#include "IModule.hpp"
+#include "SharedMemoryRing.hpp"
+
+namespace {
+
+void reply(ipc::Channel* channel, const ipc::Message& request, int status,
+           const std::string& payload = "") {
+    ipc::Message response{};
+    response.opcode = request.opcode;
+    response.sequence = request.sequence;
+    response.status = status;
+    response.setPayload(payload.data(), payload.size());
+    while (!channel->responses.tryPush(response)) {
+        ipc::cpuRelax();
+    }
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <library-path> <channel-fd>" << std::endl;
+        return 2;
+    }
+
+    char* end = nullptr;
+    errno = 0;
+    long fd = std::strtol(argv[2], &end, 10);
+    if (errno != 0 || end == argv[2] || *end != '\0' || fd < 0 || fd > INT_MAX) {
+        std::cerr << "Module worker: invalid channel fd: " << argv[2] << std::endl;
+        return 2;
+    }
+    void* mapping = mmap(nullptr, sizeof(ipc::Channel), PROT_READ | PROT_WRITE, MAP_SHARED, static_cast<int>(fd), 0);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Module worker: cannot map IPC channel" << std::endl;
+        return 2;
+    }
+    auto* channel = static_cast<ipc::Channel*>(mapping);
+    if (channel->magic != ipc::kChannelMagic || channel->version != ipc::kChannelVersion) {
+        std::cerr << "Module worker: IPC channel version mismatch" << std::endl;
+        return 2;
+    }
+
+    ipc::Message ready{};
+    ready.opcode = static_cast<uint32_t>(ipc::Opcode::READY);
+
+    void* handle = dlopen(argv[1], RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        reply(channel, ready, -1, dlerror());
+        return 1;
+    }
+
+    using CreateFunc = IModule* (*)();
+    using DestroyFunc = void (*)(IModule*);
+    auto createModule = (CreateFunc)dlsym(handle, "createModule");
+    auto destroyModule = (DestroyFunc)dlsym(handle, "destroyModule");
+    IModule* module = createModule ? createModule() : nullptr;
+    if (!module || !destroyModule) {
+        reply(channel, ready, -1, "factory functions not found");
+        return 1;
+    }
+
+    reply(channel, ready, 1, module->getName() + "\n" + module->getVersion());
+
+    const pid_t parent = getppid();
+    bool running = true;
+    while (running) {
+        ipc::Message request;
+        if (!channel->requests.pop(request, std::chrono::seconds(1))) {
+            if (getppid() != parent) {
+                break; // host went away
+            }
+            continue;
+        }
+
+        int status = -1;
+        switch (static_cast<ipc::Opcode>(request.opcode)) {
+            case ipc::Opcode::INIT: status = module->init(); break;
+            case ipc::Opcode::START: status = module->start(); break;
+            case ipc::Opcode::STOP: status = module->stop(); break;
+            case ipc::Opcode::CLEANUP: status = module->cleanup(); break;
+            case ipc::Opcode::IS_HEALTHY: status = module->isHealthy(); break;
+            case ipc::Opcode::SHUTDOWN:
+                status = 1;
+                running = false;
+                break;
+            default: break;
+        }
+        reply(channel, request, status);
+    }
+
+    destroyModule(module);
+    dlclose(handle);
+    munmap(mapping, sizeof(ipc::Channel));
+    return 0;
+}
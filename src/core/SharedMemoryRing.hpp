@@ -0,0 +1,153 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Shared-memory IPC primitives used between the host and an isolated module
+// worker process. Everything here lives inside one MAP_SHARED mapping, so the
+// types must stay trivially laid out and must not hold pointers.
+
+namespace ipc {
+
+constexpr uint32_t kChannelMagic = 0x48535750; // "HSWP"
+constexpr uint32_t kChannelVersion = 1;
+constexpr size_t kPayloadSize = 240;
+
+enum class Opcode : uint32_t {
+    READY = 1,      // worker -> host after the module object was created
+    INIT,
+    START,
+    STOP,
+    CLEANUP,
+    IS_HEALTHY,
+    SHUTDOWN
+};
+
+struct Message {
+    uint32_t opcode;
+    uint32_t sequence;
+    int32_t status;     // 1 = true, 0 = false, negative = error
+    uint32_t length;
+    char payload[kPayloadSize];
+
+    void setPayload(const char* data, size_t size) {
+        length = static_cast<uint32_t>(size < kPayloadSize ? size : kPayloadSize - 1);
+        std::memcpy(payload, data, length);
+        payload[length] = '\0';
+    }
+};
+
+// futex on a word inside the shared mapping - no FUTEX_PRIVATE_FLAG, the
+// waiter and the waker live in different processes.
+inline void futexWait(std::atomic<uint32_t>* word, uint32_t expected,
+                      std::chrono::microseconds timeout) {
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000);
+    ts.tv_nsec = static_cast<long>((timeout.count() % 1000000) * 1000);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+inline void futexWake(std::atomic<uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+}
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Single-producer / single-consumer ring. Head and tail sit on their own
+// cache lines so producer and consumer never share a line on the fast path.
+struct SpscRing {
+    static constexpr uint32_t kCapacity = 16; // power of two
+    static constexpr int kSpinIterations = 4000;
+
+    alignas(64) std::atomic<uint32_t> head;     // written by producer
+    alignas(64) std::atomic<uint32_t> tail;     // written by consumer
+    alignas(64) std::atomic<uint32_t> futexWord; // bumped on every push
+    std::atomic<uint32_t> waiters;
+    alignas(64) Message slots[kCapacity];
+
+    void reset() {
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+        futexWord.store(0, std::memory_order_relaxed);
+        waiters.store(0, std::memory_order_relaxed);
+    }
+
+    bool tryPush(const Message& message) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= kCapacity) {
+            return false; // full
+        }
+        slots[h & (kCapacity - 1)] = message;
+        head.store(h + 1, std::memory_order_release);
+
+        futexWord.fetch_add(1, std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_seq_cst) > 0) {
+            futexWake(&futexWord);
+        }
+        return true;
+    }
+
+    bool tryPop(Message& message) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) {
+            return false; // empty
+        }
+        message = slots[t & (kCapacity - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Spin briefly (the common case when the peer is active), then sleep on
+    // the futex. Returns false if nothing arrived within the timeout.
+    bool pop(Message& message, std::chrono::microseconds timeout) {
+        for (int i = 0; i < kSpinIterations; i++) {
+            if (tryPop(message)) {
+                return true;
+            }
+            cpuRelax();
+        }
+
+        uint32_t seen = futexWord.load(std::memory_order_seq_cst);
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        bool popped = tryPop(message);
+        if (!popped) {
+            futexWait(&futexWord, seen, timeout);
+            popped = tryPop(message);
+        }
+        waiters.fetch_sub(1, std::memory_order_seq_cst);
+        return popped;
+    }
+};
+
+// One mapping per isolated module: request ring (host -> worker) and
+// response ring (worker -> host).
+struct Channel {
+    uint32_t magic;
+    uint32_t version;
+    SpscRing requests;
+    SpscRing responses;
+
+    void reset() {
+        magic = kChannelMagic;
+        version = kChannelVersion;
+        requests.reset();
+        responses.reset();
+    }
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+              "shared-memory IPC requires address-free atomics");
+
+} // namespace ipc
@@ -0,0 +1,111 @@
+#include "TimerWheel.hpp"
+
+TimerWheel::TimerWheel(std::chrono::milliseconds tickDuration, Clock::time_point startTime)
+    : tick(tickDuration), start(startTime) {
+}
+
+uint64_t TimerWheel::toTick(Clock::time_point when) const {
+    if (when <= start) {
+        return 0;
+    }
+    return static_cast<uint64_t>((when - start) / tick);
+}
+
+TimerWheel::Clock::time_point TimerWheel::toTime(uint64_t tickIndex) const {
+    return start + tick * tickIndex;
+}
+
+void TimerWheel::schedule(uint64_t id, Clock::time_point when) {
+    // Round up so a timer never fires before its deadline
+    uint64_t expiryTick = toTick(when);
+    if (toTime(expiryTick) < when) {
+        expiryTick++;
+    }
+    if (expiryTick <= currentTick) {
+        expiryTick = currentTick + 1;
+    }
+
+    pending[id] = expiryTick;
+    place(Timer{id, expiryTick});
+}
+
+void TimerWheel::cancel(uint64_t id) {
+    pending.erase(id); // wheel entry becomes stale and is dropped when reached
+}
+
+void TimerWheel::place(const Timer& timer) {
+    uint64_t pageDelta = (timer.expiryTick >> kLevel0Bits) - (currentTick >> kLevel0Bits);
+
+    if (pageDelta == 0) {
+        level0[timer.expiryTick & (kLevel0Size - 1)].push_back(timer);
+    } else if (pageDelta < kLevel1Size) {
+        level1[(timer.expiryTick >> kLevel0Bits) % kLevel1Size].push_back(timer);
+    } else {
+        overflow.push_back(timer);
+    }
+}
+
+// Called when currentTick enters a new level-0 page
+void TimerWheel::cascade() {
+    uint64_t page = currentTick >> kLevel0Bits;
+
+    if (page % kLevel1Size == 0 && !overflow.empty()) {
+        std::vector<Timer> farTimers;
+        farTimers.swap(overflow);
+        for (const auto& timer : farTimers) {
+            place(timer);
+        }
+    }
+
+    std::vector<Timer> pageTimers;
+    pageTimers.swap(level1[page % kLevel1Size]);
+    for (const auto& timer : pageTimers) {
+        place(timer);
+    }
+}
+
+void TimerWheel::advance(Clock::time_point now, std::vector<uint64_t>& expired) {
+    uint64_t targetTick = toTick(now);
+
+    if (pending.empty()) {
+        // Nothing live - drop stale entries and jump straight to now
+        for (auto& slot : level0) slot.clear();
+        for (auto& slot : level1) slot.clear();
+        overflow.clear();
+        if (targetTick > currentTick) {
+            currentTick = targetTick;
+        }
+        return;
+    }
+
+    while (currentTick < targetTick) {
+        currentTick++;
+        if ((currentTick & (kLevel0Size - 1)) == 0) {
+            cascade();
+        }
+
+        auto& slot = level0[currentTick & (kLevel0Size - 1)];
+        for (const auto& timer : slot) {
+            auto it = pending.find(timer.id);
+            if (it != pending.end() && it->second == timer.expiryTick) {
+                expired.push_back(timer.id);
+                pending.erase(it);
+            }
+        }
+        slot.clear();
+    }
+}
+
+TimerWheel::Clock::time_point TimerWheel::nextExpiry() const {
+    if (pending.empty()) {
+        return Clock::time_point::max();
+    }
+
+    uint64_t pageEnd = ((currentTick >> kLevel0Bits) + 1) << kLevel0Bits;
+    for (uint64_t t = currentTick + 1; t < pageEnd; t++) {
+        if (!level0[t & (kLevel0Size - 1)].empty()) {
+            return toTime(t);
+        }
+    }
+    return toTime(pageEnd); // wake at the page boundary to cascade
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Two-level hierarchical timer wheel used by HealthMonitor to schedule
+// per-module health checks. Level 0 covers the current 256-tick page, level 1
+// the next 63 pages; anything further out waits in an overflow list and is
+// cascaded in as the wheel turns. Scheduling and firing are O(1) amortized.
+//
+// Not thread-safe - the owner serializes access.
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TimerWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(10),
+                        Clock::time_point start = Clock::now());
+
+    // (Re)schedule a timer; an existing timer with the same id is replaced
+    void schedule(uint64_t id, Clock::time_point when);
+    void cancel(uint64_t id);
+
+    // Turn the wheel up to `now`, appending the ids of fired timers
+    void advance(Clock::time_point now, std::vector<uint64_t>& expired);
+
+    // Earliest time the wheel needs to be advanced again (max() when empty).
+    // Never later than the true next expiry; may be earlier at page boundaries.
+    Clock::time_point nextExpiry() const;
+
+    bool empty() const { return pending.empty(); }
+    size_t size() const { return pending.size(); }
+
+private:
+    static constexpr uint64_t kLevel0Bits = 8;
+    static constexpr uint64_t kLevel0Size = 1u << kLevel0Bits;
+    static constexpr uint64_t kLevel1Size = 64;
+
+    struct Timer {
+        uint64_t id;
+        uint64_t expiryTick;
+    };
+
+    void place(const Timer& timer);
+    void cascade();
+    uint64_t toTick(Clock::time_point when) const;
+    Clock::time_point toTime(uint64_t tick) const;
+
+    std::chrono::milliseconds tick;
+    Clock::time_point start;
+    uint64_t currentTick = 0;
+
+    std::vector<Timer> level0[kLevel0Size];
+    std::vector<Timer> level1[kLevel1Size];
+    std::vector<Timer> overflow;
+
+    // id -> live expiry tick; stale wheel entries are skipped lazily
+    std::unordered_map<uint64_t, uint64_t> pending;
+};
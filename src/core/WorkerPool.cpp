@@ -0,0 +1,77 @@
+#include "WorkerPool.hpp"
+
+WorkerPool::WorkerPool(size_t threadCount) : state(std::make_shared<State>()) {
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+
+    state->liveWorkers = threadCount;
+    threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++) {
+        threads.emplace_back(&WorkerPool::workerLoop, state);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    shutdown();
+}
+
+void WorkerPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->stopping) {
+            return;
+        }
+        state->tasks.push_back(std::move(task));
+    }
+    state->taskReady.notify_one();
+}
+
+void WorkerPool::workerLoop(std::shared_ptr<State> state) {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->taskReady.wait(lock, [&state] { return state->stopping || !state->tasks.empty(); });
+            if (state->stopping) {
+                break;
+            }
+            task = std::move(state->tasks.front());
+            state->tasks.pop_front();
+        }
+
+        try {
+            task();
+        } catch (...) {
+            // Tasks report their own errors; never let one kill the worker
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->liveWorkers--;
+    state->workerExited.notify_all();
+}
+
+void WorkerPool::shutdown(std::chrono::milliseconds grace) {
+    if (threads.empty()) {
+        return;
+    }
+
+    bool allExited;
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->stopping = true;
+        state->tasks.clear();
+        state->taskReady.notify_all();
+        allExited = state->workerExited.wait_for(lock, grace, [this] { return state->liveWorkers == 0; });
+    }
+
+    for (auto& thread : threads) {
+        if (allExited) {
+            thread.join();
+        } else {
+            thread.detach(); // stuck in module code - let it finish on its own
+        }
+    }
+    threads.clear();
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size thread pool for running module code (health checks) off the
+// monitor thread. Tasks may hang inside a module, so shutdown() only waits a
+// grace period and then detaches any worker that is still stuck; the shared
+// state keeps those stragglers safe until they return.
+class WorkerPool {
+public:
+    explicit WorkerPool(size_t threadCount);
+    ~WorkerPool();
+
+    void submit(std::function<void()> task);
+
+    // Stop accepting work, drop queued tasks and wait up to `grace` for
+    // running ones before detaching them.
+    void shutdown(std::chrono::milliseconds grace = std::chrono::milliseconds(500));
+
+    size_t size() const { return threads.size(); }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable taskReady;
+        std::condition_variable workerExited;
+        std::deque<std::function<void()>> tasks;
+        bool stopping = false;
+        size_t liveWorkers = 0;
+    };
+
+    static void workerLoop(std::shared_ptr<State> state);
+
+    std::shared_ptr<State> state;
+    std::vector<std::thread> threads;
+};
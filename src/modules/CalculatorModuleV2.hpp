@@ -13,6 +13,14 @@ private:
     double lastResult;
     int operationCount;
     std::vector<double> history;  // New in V2: operation history
+    HeartbeatSlot* heartbeat = nullptr; // New in V2: push-based health
+
+    void publishHeartbeat() {
+        if (heartbeat) {
+            heartbeat->beat(running ? HeartbeatSlot::HEALTHY : HeartbeatSlot::UNHEALTHY,
+                            static_cast<uint32_t>(operationCount));
+        }
+    }
 
 public:
     CalculatorModuleV2(const std::string& moduleName = "Calculator", 
@@ -38,12 +46,14 @@ public:
     bool start() override {
         std::cout << "CalculatorModule V2 starting: " << name << std::endl;
         running = true;
+        publishHeartbeat();
         return true;
     }
 
     bool stop() override {
         std::cout << "CalculatorModule V2 stopping: " << name << std::endl;
         running = false;
+        publishHeartbeat();
         return true;
     }
 
@@ -66,12 +76,19 @@ public:
     bool isHealthy() override {
         return running;
     }
+
+    bool attachHeartbeat(HeartbeatSlot* slot) override {
+        heartbeat = slot;
+        publishHeartbeat();
+        return true;
+    }
     
     // Basic calculator functions (same as V1)
     double add(double a, double b) {
         lastResult = a + b;
         operationCount++;
         history.push_back(lastResult);
+        publishHeartbeat();
         std::cout << "Calculator V2: " << a << " + " << b << " = " << lastResult << std::endl;
         return lastResult;
     }
@@ -80,6 +97,7 @@ public:
         lastResult = a - b;
         operationCount++;
         history.push_back(lastResult);
+        publishHeartbeat();
         std::cout << "Calculator V2: " << a << " - " << b << " = " << lastResult << std::endl;
         return lastResult;
     }
@@ -88,6 +106,7 @@ public:
         lastResult = a * b;
         operationCount++;
         history.push_back(lastResult);
+        publishHeartbeat();
         std::cout << "Calculator V2: " << a << " * " << b << " = " << lastResult << std::endl;
         return lastResult;
     }
@@ -98,6 +117,7 @@ public:
             lastResult = a / b;
             operationCount++;
             history.push_back(lastResult);
+            publishHeartbeat();
             std::cout << "Calculator V2: " << a << " / " << b << " = " << lastResult << std::endl;
             return lastResult;
         } else {
@@ -110,6 +130,7 @@ public:
         lastResult = std::pow(base, exponent);
         operationCount++;
         history.push_back(lastResult);
+        publishHeartbeat();
         std::cout << "Calculator V2: " << base << " ^ " << exponent << " = " << lastResult << std::endl;
         return lastResult;
     }
@@ -119,6 +140,7 @@ public:
             lastResult = std::sqrt(value);
             operationCount++;
             history.push_back(lastResult);
+            publishHeartbeat();
             std::cout << "Calculator V2: sqrt(" << value << ") = " << lastResult << std::endl;
             return lastResult;
         } else {
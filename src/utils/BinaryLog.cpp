@@ -0,0 +1,317 @@
+#include "BinaryLog.hpp"
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+thread_local BinaryLog::ThreadBuffer* BinaryLog::localBuffer = nullptr;
+thread_local bool BinaryLog::bufferReleased = false;
+thread_local BinaryLog::ThreadBufferOwner BinaryLog::bufferOwner;
+
+namespace {
+
+constexpr auto kWriterIdle = std::chrono::milliseconds(5);
+constexpr auto kCalibrationInterval = std::chrono::seconds(1);
+
+int64_t realtimeNs() {
+    timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return static_cast<int64_t>(now.tv_sec) * 1000000000ll + now.tv_nsec;
+}
+
+void writeFully(int fd, struct iovec* iov, int count) {
+    while (count > 0) {
+        ssize_t written = writev(fd, iov, std::min(count, IOV_MAX));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        while (count > 0 && static_cast<size_t>(written) >= iov->iov_len) {
+            written -= static_cast<ssize_t>(iov->iov_len);
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+            iov->iov_len -= static_cast<size_t>(written);
+        }
+    }
+}
+
+} // namespace
+
+BinaryLog::Site::Site(Logger::Level level, const char* component, const char* format)
+    : level(level), component(component),
+      componentId(Logger::getInstance().componentId(component ? component : "")),
+      formatId(BinaryLog::getInstance().registerFormat(level, component, format)) {}
+
+BinaryLog& BinaryLog::getInstance() {
+    static BinaryLog* instance = new BinaryLog(); // never destroyed, usable during exit
+    return *instance;
+}
+
+BinaryLog::BinaryLog()
+    : enabled(false), droppedRecords(0), fd(-1), formatsWritten(0), calibrationTicks(0),
+      calibrationRealtimeNs(0), ticksPerNs(1.0), writerRunning(false) {}
+
+uint32_t BinaryLog::registerFormat(Logger::Level level, const char* component, const char* format) {
+    std::lock_guard<std::mutex> lock(formatMutex);
+    formats.push_back({level, component ? component : "", format ? format : ""});
+    return static_cast<uint32_t>(formats.size() - 1);
+}
+
+// The ring may be freed by the writer as soon as it is retired, so the
+// thread drops its pointer and never takes a new ring after that
+BinaryLog::ThreadBufferOwner::~ThreadBufferOwner() {
+    if (localBuffer) {
+        localBuffer->retired.store(true, std::memory_order_release);
+        localBuffer = nullptr;
+    }
+    bufferReleased = true;
+}
+
+// Null once this thread's ring has been retired (thread_local destructors ran)
+BinaryLog::ThreadBuffer* BinaryLog::threadBuffer() {
+    if (!localBuffer) {
+        if (bufferReleased) {
+            return nullptr;
+        }
+        (void)&bufferOwner;
+        localBuffer = new ThreadBuffer();
+        std::lock_guard<std::mutex> lock(bufferMutex);
+        buffers.push_back(localBuffer);
+    }
+    return localBuffer;
+}
+
+void BinaryLog::logText(const Site& site, const char* format, const unsigned char* args, size_t size) {
+    std::string message;
+    render(format, args, size, message);
+    Logger::getInstance().log(site.componentId, site.level, message, site.component ? site.component : "");
+}
+
+bool BinaryLog::render(const std::string& format, const unsigned char* args, size_t size, std::string& out) {
+    const unsigned char* end = args + size;
+    size_t start = 0;
+    bool wellFormed = true;
+    for (size_t at = format.find("{}"); at != std::string::npos; at = format.find("{}", start)) {
+        out.append(format, start, at - start);
+        start = at + 2;
+        if (args == end) {
+            out += "{}"; // more placeholders than arguments
+            continue;
+        }
+
+        uint8_t tag = *args++;
+        if (tag == STRING) {
+            uint32_t length;
+            if (end - args < 4 || (memcpy(&length, args, 4), static_cast<size_t>(end - args - 4) < length)) {
+                wellFormed = false;
+                break;
+            }
+            out.append(reinterpret_cast<const char*>(args + 4), length);
+            args += 4 + length;
+            continue;
+        }
+        if (end - args < 8) {
+            wellFormed = false;
+            break;
+        }
+        uint64_t bits;
+        memcpy(&bits, args, 8);
+        args += 8;
+        switch (tag) {
+            case INT: out += std::to_string(static_cast<int64_t>(bits)); break;
+            case UINT: out += std::to_string(bits); break;
+            case BOOL: out += bits ? "true" : "false"; break;
+            case CHAR: out += static_cast<char>(bits); break;
+            case FLOAT: {
+                double value;
+                memcpy(&value, &bits, 8);
+                char text[32];
+                snprintf(text, sizeof(text), "%g", value);
+                out += text;
+                break;
+            }
+            default: wellFormed = false; break;
+        }
+        if (!wellFormed) {
+            break;
+        }
+    }
+    if (start < format.size()) {
+        out.append(format, start, std::string::npos);
+    }
+    return wellFormed;
+}
+
+bool BinaryLog::open(const std::string& path) {
+    std::lock_guard<std::mutex> openLock(openMutex);
+    if (writerRunning.load()) {
+        Logger::getInstance().warning("Binary log already open", "BinaryLog");
+        return false;
+    }
+
+    int file = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (file < 0) {
+        Logger::getInstance().error("Cannot open binary log " + path + ": " + strerror(errno), "BinaryLog");
+        return false;
+    }
+    FileHeader header{kMagic, kVersion};
+    struct iovec iov = {&header, sizeof(header)};
+    writeFully(file, &iov, 1);
+
+    {
+        std::lock_guard<std::mutex> lock(drainMutex);
+        fd = file;
+        formatsWritten = 0;
+        // Ticks per ns over a short window; every later calibration record
+        // refines it over the whole time the file has been open
+        calibrationTicks = readTicks();
+        calibrationRealtimeNs = realtimeNs();
+        auto wallStart = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        uint64_t ticks = readTicks();
+        auto wallNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - wallStart).count();
+        ticksPerNs = wallNs > 0 ? static_cast<double>(ticks - calibrationTicks) / static_cast<double>(wallNs) : 1.0;
+        writeCalibration();
+    }
+
+    // Records still in the rings at exit would be lost otherwise
+    static bool exitHook = (std::atexit([]() { BinaryLog::getInstance().close(); }), true);
+    (void)exitHook;
+
+    writerRunning.store(true, std::memory_order_release);
+    writerThread = std::thread(&BinaryLog::writerLoop, this);
+    enabled.store(true, std::memory_order_release);
+    Logger::getInstance().info("Binary log opened: " + path, "BinaryLog");
+    return true;
+}
+
+void BinaryLog::close() {
+    std::lock_guard<std::mutex> openLock(openMutex);
+    enabled.store(false, std::memory_order_seq_cst);
+    if (!writerThread.joinable()) {
+        return;
+    }
+    // Producers that passed the enabled check finish their push before the
+    // last drain, so no record is left behind in a ring
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex);
+        for (ThreadBuffer* buffer : buffers) {
+            while (buffer->inUse.load(std::memory_order_seq_cst)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    writerRunning.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wakeCondition.notify_one();
+    }
+    writerThread.join(); // drains one last time
+
+    std::lock_guard<std::mutex> lock(drainMutex);
+    ::close(fd);
+    fd = -1;
+}
+
+void BinaryLog::flush() {
+    if (enabled.load(std::memory_order_acquire)) {
+        drain();
+    }
+}
+
+void BinaryLog::writerLoop() {
+    while (writerRunning.load(std::memory_order_acquire)) {
+        drain();
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        if (writerRunning.load(std::memory_order_acquire)) {
+            wakeCondition.wait_for(lock, kWriterIdle);
+        }
+    }
+    drain();
+}
+
+// Caller holds drainMutex
+void BinaryLog::writeCalibration() {
+    CalibrationRecord record{};
+    record.kind = CALIBRATION;
+    uint64_t ticks = readTicks();
+    int64_t now = realtimeNs();
+    if (now > calibrationRealtimeNs + 1000000) {
+        ticksPerNs = static_cast<double>(ticks - calibrationTicks) / static_cast<double>(now - calibrationRealtimeNs);
+    }
+    record.ticks = ticks;
+    record.realtimeNs = now;
+    record.ticksPerNs = ticksPerNs;
+    struct iovec iov = {&record, sizeof(record)};
+    writeFully(fd, &iov, 1);
+    lastCalibration = std::chrono::steady_clock::now();
+}
+
+// Formats first, then every thread's ring. A record may still reach the
+// file before the definition of a format registered during this pass; the
+// decoder reads the whole file before rendering, so that is fine.
+void BinaryLog::drain() {
+    std::lock_guard<std::mutex> lock(drainMutex);
+    if (fd < 0) {
+        return;
+    }
+
+    std::vector<std::string> definitions;
+    {
+        std::lock_guard<std::mutex> formatLock(formatMutex);
+        for (; formatsWritten < formats.size(); formatsWritten++) {
+            const FormatEntry& entry = formats[formatsWritten];
+            std::string text = entry.component + '\0' + entry.format.substr(0, 60000) + '\0';
+            FormatRecord record{FORMAT, static_cast<uint8_t>(entry.level), static_cast<uint16_t>(text.size()),
+                                static_cast<uint32_t>(formatsWritten)};
+            definitions.push_back(std::string(reinterpret_cast<const char*>(&record), sizeof(record)) + text);
+        }
+    }
+    for (std::string& definition : definitions) {
+        struct iovec iov = {&definition[0], definition.size()};
+        writeFully(fd, &iov, 1);
+    }
+    if (std::chrono::steady_clock::now() - lastCalibration >= kCalibrationInterval) {
+        writeCalibration();
+    }
+
+    std::vector<ThreadBuffer*> snapshot;
+    {
+        std::lock_guard<std::mutex> bufferLock(bufferMutex);
+        snapshot = buffers;
+    }
+    std::vector<ThreadBuffer*> finished;
+    for (ThreadBuffer* buffer : snapshot) {
+        bool retired = buffer->retired.load(std::memory_order_acquire);
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+        if (head != tail) {
+            // Records are stored exactly as they go into the file
+            size_t offset = tail % kThreadBufferSize;
+            size_t bytes = head - tail;
+            size_t first = std::min(bytes, kThreadBufferSize - offset);
+            struct iovec iov[2] = {{buffer->data + offset, first}, {buffer->data, bytes - first}};
+            writeFully(fd, iov, bytes > first ? 2 : 1);
+            buffer->tail.store(head, std::memory_order_release);
+        }
+        if (retired) {
+            finished.push_back(buffer);
+        }
+    }
+
+    if (!finished.empty()) {
+        std::lock_guard<std::mutex> bufferLock(bufferMutex);
+        for (ThreadBuffer* buffer : finished) {
+            buffers.erase(std::find(buffers.begin(), buffers.end(), buffer));
+            delete buffer;
+        }
+    }
+}
@@ -0,0 +1,282 @@
+#pragma once
+#include "Logger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <condition_variable>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Deferred-format logging. A call site is registered once (function-local
+// static) and from then on only its format ID, a timestamp in ticks and the
+// raw argument bytes are copied into a per-thread ring. A writer thread
+// appends those records to a binary file that tools/log_decoder renders to
+// text later. While no binary file is open the same call sites format their
+// message and go through Logger as usual.
+//
+//   HOTSWAP_LOG_FMT(Logger::Level::INFO, "ModuleManager", "Module loaded: {} v{}", name, version);
+//
+// "{}" is replaced by the next argument. Arguments may be integers, floating
+// point, bool, char, const char* and std::string.
+#define HOTSWAP_LOG_FIRST_(first, ...) first
+#define HOTSWAP_LOG_FMT(level, component, ...)                                                    \
+    do {                                                                                          \
+        if constexpr (static_cast<int>(level) >= HOTSWAP_MIN_LOG_LEVEL) {                         \
+            HOTSWAP_LOG_COMPONENT_(component);                                                    \
+            if (Logger::getInstance().isLevelEnabled(level, hotswapLogComponent)) {               \
+                static const BinaryLog::Site hotswapLogSite(level, component,                      \
+                                                            HOTSWAP_LOG_FIRST_(__VA_ARGS__, 0));  \
+                BinaryLog::getInstance().log(hotswapLogSite, __VA_ARGS__);                       \
+            }                                                                                     \
+        }                                                                                         \
+    } while (0)
+
+class BinaryLog {
+public:
+    // One registered call site; format and component are copied on registration,
+    // so sites inside modules may be unloaded
+    struct Site {
+        Site(Logger::Level level, const char* component, const char* format);
+        Logger::Level level;
+        const char* component;
+        Logger::ComponentId componentId;
+        uint32_t formatId;
+    };
+
+    // File layout: FileHeader, then records that each start with a RecordKind byte
+    static constexpr uint32_t kMagic = 0x4C425348; // "HSBL"
+    static constexpr uint32_t kVersion = 1;
+    enum RecordKind : uint8_t {
+        FORMAT = 'F',      // FormatRecord, component '\0' format '\0'
+        CALIBRATION = 'C', // CalibrationRecord
+        MESSAGE = 'L'      // MessageRecord, encoded arguments
+    };
+    // Argument tags; every value but a string is 8 bytes
+    enum ArgTag : uint8_t { INT = 'i', UINT = 'u', FLOAT = 'f', BOOL = 'b', CHAR = 'c', STRING = 's' };
+
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+    };
+    struct FormatRecord {
+        uint8_t kind;
+        uint8_t level;
+        uint16_t textBytes;
+        uint32_t formatId;
+    };
+    struct CalibrationRecord {
+        uint8_t kind;
+        uint8_t reserved[7];
+        uint64_t ticks;
+        int64_t realtimeNs;
+        double ticksPerNs;
+    };
+    struct MessageRecord {
+        uint8_t kind;
+        uint8_t reserved;
+        uint16_t argBytes;
+        uint32_t formatId;
+        uint64_t ticks;
+    };
+
+    static constexpr size_t kMaxStringArg = 1024; // longer strings are truncated
+    static constexpr size_t kMaxRecord = 4096;
+    static constexpr size_t kThreadBufferSize = 1 << 16;
+
+    static BinaryLog& getInstance();
+
+    // Start writing records to a new binary file (truncated). False on error.
+    bool open(const std::string& path);
+    // Drain everything and stop writing; call sites go back to text
+    void close();
+    bool isOpen() const { return enabled.load(std::memory_order_relaxed); }
+    // Returns once records logged before the call are in the file
+    void flush();
+    // Records lost because a thread's ring was full
+    uint64_t getDroppedRecords() const { return droppedRecords.load(std::memory_order_relaxed); }
+
+    template <typename... Args>
+    void log(const Site& site, const char* format, const Args&... args);
+
+    static uint64_t readTicks();
+    // Substitutes encoded arguments into a format; used by the text fallback
+    // and the decoder. Returns false if the argument bytes are malformed.
+    static bool render(const std::string& format, const unsigned char* args, size_t size, std::string& out);
+
+    BinaryLog(const BinaryLog&) = delete;
+    BinaryLog& operator=(const BinaryLog&) = delete;
+
+private:
+    BinaryLog();
+
+    // Single-producer ring owned by one thread, drained by the writer
+    struct ThreadBuffer {
+        alignas(64) std::atomic<uint64_t> head{0};
+        alignas(64) std::atomic<uint64_t> tail{0};
+        std::atomic<bool> inUse{false}; // producer between its enabled check and the push; close() waits
+        std::atomic<bool> retired{false};
+        unsigned char data[kThreadBufferSize];
+    };
+    struct FormatEntry {
+        Logger::Level level;
+        std::string component;
+        std::string format;
+    };
+
+    uint32_t registerFormat(Logger::Level level, const char* component, const char* format);
+    ThreadBuffer* threadBuffer();
+    void logText(const Site& site, const char* format, const unsigned char* args, size_t size);
+    void writerLoop();
+    void drain();
+    void writeCalibration();
+
+    // Encoding, sized first so the record can be claimed in one step
+    static size_t argSize(const std::string& value) { return 5 + std::min(value.size(), kMaxStringArg); }
+    static size_t argSize(const char* value) { return 5 + (value ? strnlen(value, kMaxStringArg) : 0); }
+    template <typename T>
+    static size_t argSize(const T&) {
+        static_assert(std::is_arithmetic<T>::value, "Unsupported binary log argument type");
+        return 9;
+    }
+    static unsigned char* encodeString(unsigned char* out, const char* value, size_t length);
+    static unsigned char* encode(unsigned char* out, const std::string& value) {
+        return encodeString(out, value.data(), std::min(value.size(), kMaxStringArg));
+    }
+    static unsigned char* encode(unsigned char* out, const char* value) {
+        return encodeString(out, value ? value : "", value ? strnlen(value, kMaxStringArg) : 0);
+    }
+    template <typename T>
+    static unsigned char* encode(unsigned char* out, const T& value);
+
+    // Retires this thread's ring on thread exit; the writer frees it once drained
+    struct ThreadBufferOwner {
+        ~ThreadBufferOwner();
+    };
+
+    static thread_local ThreadBuffer* localBuffer;
+    static thread_local bool bufferReleased; // ring retired; later lines from this thread go to text
+    static thread_local ThreadBufferOwner bufferOwner;
+
+    std::atomic<bool> enabled;
+    std::atomic<uint64_t> droppedRecords;
+    std::mutex formatMutex;
+    std::vector<FormatEntry> formats;
+    std::mutex bufferMutex;
+    std::vector<ThreadBuffer*> buffers;
+
+    std::mutex drainMutex; // one drain at a time: writer thread or flush()
+    int fd;
+    size_t formatsWritten;
+    uint64_t calibrationTicks;
+    int64_t calibrationRealtimeNs;
+    double ticksPerNs;
+    std::chrono::steady_clock::time_point lastCalibration;
+
+    std::mutex openMutex;
+    std::atomic<bool> writerRunning;
+    std::thread writerThread;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+};
+
+inline uint64_t BinaryLog::readTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+#endif
+}
+
+inline unsigned char* BinaryLog::encodeString(unsigned char* out, const char* value, size_t length) {
+    *out++ = STRING;
+    uint32_t length32 = static_cast<uint32_t>(length);
+    memcpy(out, &length32, sizeof(length32));
+    memcpy(out + sizeof(length32), value, length);
+    return out + sizeof(length32) + length;
+}
+
+template <typename T>
+unsigned char* BinaryLog::encode(unsigned char* out, const T& value) {
+    if constexpr (std::is_same<T, bool>::value) {
+        *out++ = BOOL;
+        uint64_t bits = value ? 1 : 0;
+        memcpy(out, &bits, 8);
+    } else if constexpr (std::is_same<T, char>::value) {
+        *out++ = CHAR;
+        uint64_t bits = static_cast<unsigned char>(value);
+        memcpy(out, &bits, 8);
+    } else if constexpr (std::is_floating_point<T>::value) {
+        *out++ = FLOAT;
+        double bits = static_cast<double>(value);
+        memcpy(out, &bits, 8);
+    } else if constexpr (std::is_signed<T>::value) {
+        *out++ = INT;
+        int64_t bits = static_cast<int64_t>(value);
+        memcpy(out, &bits, 8);
+    } else {
+        *out++ = UINT;
+        uint64_t bits = static_cast<uint64_t>(value);
+        memcpy(out, &bits, 8);
+    }
+    return out + 8;
+}
+
+template <typename... Args>
+void BinaryLog::log(const Site& site, const char* format, const Args&... args) {
+    const size_t argBytes = (size_t{0} + ... + argSize(args));
+    const size_t recordBytes = sizeof(MessageRecord) + argBytes;
+    if (recordBytes > kMaxRecord) {
+        droppedRecords.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    unsigned char record[kMaxRecord];
+    MessageRecord header{MESSAGE, 0, static_cast<uint16_t>(argBytes), site.formatId, readTicks()};
+    memcpy(record, &header, sizeof(header));
+    unsigned char* out = record + sizeof(header);
+    ((out = encode(out, args)), ...);
+    (void)out;
+
+    // Levels only kept by the flight recorder never go to the binary file
+    if (!enabled.load(std::memory_order_acquire) || !Logger::getInstance().isLevelWritten(site.level, site.componentId)) {
+        logText(site, format, record + sizeof(header), argBytes);
+        return;
+    }
+
+    // Announce the push, then check again: close() clears enabled before it
+    // waits on inUse, so either it sees this push or this sees it closing
+    ThreadBuffer* buffer = threadBuffer();
+    if (!buffer) {
+        logText(site, format, record + sizeof(header), argBytes);
+        return;
+    }
+    buffer->inUse.store(true, std::memory_order_seq_cst);
+    if (!enabled.load(std::memory_order_seq_cst)) {
+        buffer->inUse.store(false, std::memory_order_release);
+        logText(site, format, record + sizeof(header), argBytes);
+        return;
+    }
+    uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    if (kThreadBufferSize - (head - buffer->tail.load(std::memory_order_acquire)) < recordBytes) {
+        buffer->inUse.store(false, std::memory_order_release);
+        droppedRecords.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    size_t offset = head % kThreadBufferSize;
+    size_t first = std::min(recordBytes, kThreadBufferSize - offset);
+    memcpy(buffer->data + offset, record, first);
+    memcpy(buffer->data, record + first, recordBytes - first);
+    buffer->head.store(head + recordBytes, std::memory_order_release);
+    buffer->inUse.store(false, std::memory_order_release);
+}
@@ -1,21 +1,188 @@
 #include "Logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <functional>
+#include <cstdlib>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <vector>
+#include <dirent.h>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#ifdef HOTSWAP_HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 // Initialize static member
 Logger* Logger::instance = nullptr;
 
+namespace {
+
+constexpr size_t kWriteBatch = 64; // lines per writev
+// The writer polls this often when idle; producers only wake it early once
+// the queue is half full, so a log call never pays for a context switch
+constexpr auto kWriterIdle = std::chrono::milliseconds(5);
+
+// writev until everything is out, picking up after short writes
+void writeFully(int fd, struct iovec* iov, int count) {
+    while (count > 0) {
+        ssize_t written = writev(fd, iov, std::min(count, IOV_MAX));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        while (count > 0 && static_cast<size_t>(written) >= iov->iov_len) {
+            written -= static_cast<ssize_t>(iov->iov_len);
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+            iov->iov_len -= static_cast<size_t>(written);
+        }
+    }
+}
+
+struct iovec piece(const std::string& text) {
+    return {const_cast<char*>(text.data()), text.size()};
+}
+
+// Per-thread line buffer. Reached through a plain pointer so that logging
+// from destructors running after this thread's thread_local cleanup still
+// works (it then allocates a buffer that is never freed).
+thread_local std::string* lineBuffer = nullptr;
+thread_local bool lineBufferReleased = false;
+struct LineBufferOwner {
+    ~LineBufferOwner() {
+        delete lineBuffer;
+        lineBuffer = nullptr;
+        lineBufferReleased = true;
+    }
+};
+thread_local LineBufferOwner lineBufferOwner;
+
+std::string& threadLineBuffer() {
+    if (!lineBuffer) {
+        if (!lineBufferReleased) {
+            (void)&lineBufferOwner;
+        }
+        lineBuffer = new std::string();
+        lineBuffer->reserve(256);
+    }
+    lineBuffer->clear();
+    return *lineBuffer;
+}
+
+// When the file was started: birth time where the filesystem records it,
+// else the last modification (which at least catches stale files)
+time_t fileStartTime(int fd, const struct stat& info) {
+#ifdef STATX_BTIME
+    struct statx extended;
+    if (statx(fd, "", AT_EMPTY_PATH, STATX_BTIME, &extended) == 0 && (extended.stx_mask & STATX_BTIME)) {
+        return static_cast<time_t>(extended.stx_btime.tv_sec);
+    }
+#endif
+    return info.st_mtime;
+}
+
+int64_t steadyNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Crash handler state, plain data so the handler can read it
+const int kCrashSignals[] = {SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL};
+constexpr size_t kCrashStackSize = 64 * 1024;
+char crashDumpPath[PATH_MAX];
+struct sigaction previousActions[NSIG];
+volatile sig_atomic_t crashing = 0;
+std::atomic<bool> crashHandlerInstalled{false};
+
+// Each thread needs its own alternate stack for a stack overflow there to
+// still get dumped. A thread gets one on its first log line once the handler
+// is installed, unless it already has one (a sanitizer's, say).
+struct AlternateStack {
+    bool checked = false;
+    char* memory = nullptr;
+    ~AlternateStack() {
+        if (memory) {
+            stack_t disable = {};
+            disable.ss_flags = SS_DISABLE;
+            sigaltstack(&disable, nullptr);
+            delete[] memory;
+        }
+    }
+};
+thread_local AlternateStack alternateStack;
+
+void ensureAlternateStack() {
+    alternateStack.checked = true;
+    stack_t current;
+    if (sigaltstack(nullptr, &current) == 0 && !(current.ss_flags & SS_DISABLE)) {
+        return;
+    }
+    alternateStack.memory = new char[kCrashStackSize];
+    stack_t stack = {};
+    stack.ss_sp = alternateStack.memory;
+    stack.ss_size = kCrashStackSize;
+    sigaltstack(&stack, nullptr);
+}
+
+// write() is async-signal-safe, writev is not guaranteed to be
+void writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+}
+
+void writeText(int fd, const char* text) {
+    writeAll(fd, text, strlen(text));
+}
+
+} // namespace
+
 Logger::Logger() 
-    : currentLevel(Level::INFO), consoleOutput(true), logFilename("hotswap_system.log") {
-    
-    // Open log file
-    logFile.open(logFilename, std::ios::app);
-    if (!logFile.is_open()) {
-        std::cerr << "Failed to open log file: " << logFilename << std::endl;
+    : logFd(-1), currentLevel(Level::INFO), componentLevelsSet(false), consoleOutput(true), coarseTimestamps(false),
+      outputFormat(OutputFormat::TEXT),
+      logFilename("hotswap_system.log"),
+      queueMask(0), enqueuePos(0), dequeuePos(0), writtenPos(0), droppedMessages(0), suppressedMessages(0), reportedDrops(0),
+      overflowPolicy(OverflowPolicy::BLOCK), asyncMode(false), writerRunning(false), writerSleeping(false),
+      recorderMask(0), recorderPos(0), recorderEnabled(false), recordLevel(Level::DEBUG),
+      fileBytes(0), prepareBytes(0), preparedFd(-1), prepareGeneration(0), housekeepingStarted(false) {
+    for (size_t id = 0; id < kMaxComponents; id++) {
+        componentNames[id].store(nullptr, std::memory_order_relaxed);
+        componentEnabled[id].store(Level::INFO, std::memory_order_relaxed);
+        componentWritten[id].store(Level::INFO, std::memory_order_relaxed);
+        componentOverrides[id] = -1;
     }
+
+    // Open log file
+    openLogFile();
 }
 
 Logger::~Logger() {
-    if (logFile.is_open()) {
-        logFile.close();
+    stopWriter();
+    if (logFd >= 0) {
+        close(logFd);
     }
 }
 
@@ -26,53 +193,514 @@ Logger& Logger::getInstance() {
     return *instance;
 }
 
+// O_APPEND fd instead of a stream: every line is one writev, nothing is
+// buffered in user space that would need flushing
+void Logger::openLogFile() {
+    logFd = open(logFilename.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (logFd < 0) {
+        std::cerr << "Failed to open log file: " << logFilename << std::endl;
+    }
+    struct stat info;
+    fileBytes = (logFd >= 0 && fstat(logFd, &info) == 0) ? static_cast<uint64_t>(info.st_size) : 0;
+    fileOpened = std::chrono::steady_clock::now();
+    if (fileBytes > 0) {
+        // An existing log keeps its age across restarts, or maxAge would
+        // never be reached on hosts that restart more often than that
+        time_t age = time(nullptr) - fileStartTime(logFd, info);
+        if (age > 0) {
+            fileOpened -= std::chrono::seconds(age);
+        }
+    }
+}
+
 void Logger::log(Level level, const std::string& message, const std::string& module) {
+    log(level, message, module, {});
+}
+
+// Without any component level set every component follows the global one,
+// so the name is only looked up once an override exists
+void Logger::log(Level level, const std::string& message, const std::string& module,
+                 std::initializer_list<Field> fields) {
+    ComponentId component = componentLevelsSet.load(std::memory_order_relaxed) ? findComponent(module) : 0;
+    log(component, level, message, module, fields);
+}
+
+void Logger::log(ComponentId component, Level level, const std::string& message, const std::string& module,
+                 std::initializer_list<Field> fields) {
     // Skip if log level is too low
-    if (level < currentLevel) {
+    bool written = level >= componentWritten[component].load(std::memory_order_relaxed);
+    bool recorded = recorderEnabled.load(std::memory_order_acquire) &&
+                    level >= recordLevel.load(std::memory_order_relaxed);
+    if (!written && !recorded) {
         return;
     }
 
-    std::lock_guard<std::mutex> lock(logMutex);
-    
-    std::string timestamp = getCurrentTimestamp();
-    std::string levelStr = levelToString(level);
-    std::string logEntry;
+    if (!alternateStack.checked && crashHandlerInstalled.load(std::memory_order_relaxed)) {
+        ensureAlternateStack();
+    }
+    std::string& line = threadLineBuffer();
+    formatLine(line, level, message, module, fields);
+    if (recorded) {
+        recordLine(line);
+    }
+    if (!written) {
+        return;
+    }
 
-    // Format log entry
-    if (module.empty()) {
-        logEntry = "[" + timestamp + "] [" + levelStr + "] " + message;
-    } else {
-        logEntry = "[" + timestamp + "] [" + levelStr + "] [" + module + "] " + message;
+    if (asyncMode.load(std::memory_order_acquire) && enqueue(level, line)) {
+        return;
+    }
+    if (!line.empty()) { // empty: dropped on overflow
+        std::lock_guard<std::mutex> lock(logMutex);
+        writeLine(level, line);
+    }
+}
+
+void Logger::formatLine(std::string& out, Level level, const std::string& message, const std::string& module,
+                        std::initializer_list<Field> fields) {
+    char timestamp[kTimestampBufferSize];
+    size_t timestampLength = formatTimestamp(timestamp);
+    const char* levelStr = levelName(level);
+
+    if (outputFormat.load(std::memory_order_relaxed) == OutputFormat::JSON) {
+        out += "{\"ts\":\"";
+        out.append(timestamp, timestampLength);
+        out += "\",\"level\":\"";
+        out += levelStr;
+        out += '"';
+        if (!module.empty()) {
+            out += ",\"component\":";
+            appendJsonString(out, module.data(), module.size());
+        }
+        out += ",\"msg\":";
+        appendJsonString(out, message.data(), message.size());
+        for (const Field& field : fields) {
+            out += ',';
+            appendJsonString(out, field.key, strlen(field.key));
+            out += ':';
+            appendFieldValue(out, field, true);
+        }
+        out += '}';
+        return;
+    }
+
+    out += '[';
+    out.append(timestamp, timestampLength);
+    out += "] [";
+    out += levelStr;
+    out += "] ";
+    if (!module.empty()) {
+        out += '[';
+        out += module;
+        out += "] ";
     }
+    out += message;
+    for (const Field& field : fields) {
+        out += ' ';
+        out += field.key;
+        out += '=';
+        appendFieldValue(out, field, false);
+    }
+}
+
+void Logger::appendJsonString(std::string& out, const char* text, size_t length) {
+    static const char hex[] = "0123456789abcdef";
+    out += '"';
+    for (size_t i = 0; i < length; i++) {
+        auto c = static_cast<unsigned char>(text[i]);
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    out += "\\u00";
+                    out += hex[c >> 4];
+                    out += hex[c & 0xf];
+                } else {
+                    out += static_cast<char>(c);
+                }
+        }
+    }
+    out += '"';
+}
+
+// Text output quotes a string only when it would not read back as one value
+void Logger::appendFieldValue(std::string& out, const Field& field, bool json) {
+    char number[32];
+    std::to_chars_result result{number, std::errc()};
+    switch (field.type) {
+        case Field::STRING: {
+            const char* text = field.text.data;
+            size_t length = field.text.length;
+            bool quote = json || length == 0 ||
+                         std::any_of(text, text + length, [](char c) {
+                             return c == ' ' || c == '"' || c == '=' || static_cast<unsigned char>(c) < 0x20;
+                         });
+            if (quote) {
+                appendJsonString(out, text, length);
+            } else {
+                out.append(text, length);
+            }
+            return;
+        }
+        case Field::BOOL:
+            out += field.boolean ? "true" : "false";
+            return;
+        case Field::INT:
+            result = std::to_chars(number, number + sizeof(number), field.integer);
+            break;
+        case Field::UINT:
+            result = std::to_chars(number, number + sizeof(number), static_cast<uint64_t>(field.integer));
+            break;
+        case Field::FLOAT:
+            if (json && !std::isfinite(field.number)) {
+                out += "null"; // JSON has no NaN or infinity
+                return;
+            }
+            result = std::to_chars(number, number + sizeof(number), field.number);
+            break;
+    }
+    out.append(number, result.ptr);
+}
+
+// Synchronous path, caller holds logMutex
+void Logger::writeLine(Level level, const std::string& line) {
+    static const std::string newline = "\n";
 
     // Write to file
-    if (logFile.is_open()) {
-        logFile << logEntry << std::endl;
-        logFile.flush();
+    if (logFd >= 0) {
+        rotateIfNeeded(line.size() + 1);
+        struct iovec iov[2] = {piece(line), piece(newline)};
+        writeFully(logFd, iov, 2);
+        fileBytes += line.size() + 1;
     }
 
     // Write to console with colors
     if (consoleOutput) {
         std::string colorCode = getColorCode(level);
         std::string resetColor = getResetColor();
-        std::cout << colorCode << logEntry << resetColor << std::endl;
+        std::cout << colorCode << line << resetColor << std::endl;
+    }
+}
+
+// False if async mode was switched off underneath us - the caller writes
+// the line itself. On a dropped message the line is cleared.
+bool Logger::enqueue(Level level, std::string& line) {
+    QueueSlot* slot = nullptr;
+    uint64_t pos = enqueuePos.load(std::memory_order_relaxed);
+    while (!slot) {
+        QueueSlot& candidate = queue[pos & queueMask];
+        uint64_t sequence = candidate.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<int64_t>(sequence - pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot = &candidate;
+            }
+        } else if (diff > 0) {
+            pos = enqueuePos.load(std::memory_order_relaxed); // lost a race, retry
+        } else {
+            // Full
+            if (overflowPolicy.load(std::memory_order_relaxed) != OverflowPolicy::BLOCK) {
+                droppedMessages.fetch_add(1, std::memory_order_relaxed);
+                line.clear();
+                return false;
+            }
+            if (!asyncMode.load(std::memory_order_acquire)) {
+                return false;
+            }
+            wakeWriter();
+            std::this_thread::yield();
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->level = level;
+    slot->line.swap(line); // the producer keeps the slot's old buffer for its next line
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    if (pos - writtenPos.load(std::memory_order_relaxed) >= (queueMask + 1) / 2) {
+        wakeWriter();
+    }
+    return true;
+}
+
+void Logger::wakeWriter() {
+    if (writerSleeping.load(std::memory_order_relaxed) && writerSleeping.exchange(false)) {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wakeCondition.notify_one();
+    }
+}
+
+// Takes up to kWriteBatch published lines, writes them with one writev per
+// destination and only then hands the slots back to producers
+size_t Logger::writeQueuedBatch() {
+    static const std::string newline = "\n";
+    static const std::string resetNewline = "\033[0m\n";
+
+    QueueSlot* batch[kWriteBatch];
+    size_t count = 0;
+    while (count < kWriteBatch) {
+        QueueSlot& slot = queue[(dequeuePos + count) & queueMask];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + count + 1) {
+            break;
+        }
+        batch[count++] = &slot;
+    }
+
+    // Only drops that happen while reporting is on get reported
+    std::string dropNotice;
+    uint64_t dropped = droppedMessages.load(std::memory_order_relaxed);
+    if (dropped != reportedDrops && overflowPolicy.load(std::memory_order_relaxed) == OverflowPolicy::DROP_AND_REPORT) {
+        formatLine(dropNotice, Level::WARNING,
+                   std::to_string(dropped - reportedDrops) + " log messages dropped (async queue full)", "Logger", {});
+    }
+    reportedDrops = dropped;
+    if (count == 0 && dropNotice.empty()) {
+        return 0;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+        struct iovec iov[3 * (kWriteBatch + 1)];
+        if (logFd >= 0) {
+            int pieces = 0;
+            size_t bytes = 0;
+            for (size_t i = 0; i < count; i++) {
+                iov[pieces++] = piece(batch[i]->line);
+                iov[pieces++] = piece(newline);
+                bytes += batch[i]->line.size() + 1;
+            }
+            if (!dropNotice.empty()) {
+                iov[pieces++] = piece(dropNotice);
+                iov[pieces++] = piece(newline);
+                bytes += dropNotice.size() + 1;
+            }
+            rotateIfNeeded(bytes);
+            writeFully(logFd, iov, pieces);
+            fileBytes += bytes;
+        }
+        if (consoleOutput) {
+            std::string colors[kWriteBatch];
+            int pieces = 0;
+            for (size_t i = 0; i < count; i++) {
+                colors[i] = getColorCode(batch[i]->level);
+                iov[pieces++] = piece(colors[i]);
+                iov[pieces++] = piece(batch[i]->line);
+                iov[pieces++] = piece(resetNewline);
+            }
+            if (!dropNotice.empty()) {
+                iov[pieces++] = piece(dropNotice);
+                iov[pieces++] = piece(newline);
+            }
+            writeFully(STDOUT_FILENO, iov, pieces);
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        batch[i]->line.clear();
+        batch[i]->sequence.store(dequeuePos + i + queueMask + 1, std::memory_order_release);
+    }
+    dequeuePos += count;
+    writtenPos.store(dequeuePos, std::memory_order_release);
+    return count ? count : 1;
+}
+
+void Logger::writerLoop() {
+    while (true) {
+        if (writeQueuedBatch() > 0) {
+            continue;
+        }
+        {
+            // Wake anyone in flush() - the queue is drained up to writtenPos
+            std::lock_guard<std::mutex> lock(wakeMutex);
+        }
+        flushedCondition.notify_all();
+        if (!writerRunning.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        writerSleeping.store(true);
+        if (writerRunning.load(std::memory_order_acquire)) {
+            wakeCondition.wait_for(lock, kWriterIdle);
+        }
+        writerSleeping.store(false);
+    }
+}
+
+void Logger::enableAsyncMode(bool enable, size_t queueCapacity) {
+    std::lock_guard<std::mutex> asyncLock(asyncMutex);
+    if (!enable) {
+        stopWriter();
+        return;
+    }
+    if (writerRunning.load()) {
+        return;
+    }
+
+    if (!queue) {
+        size_t capacity = 2;
+        while (capacity < queueCapacity) {
+            capacity <<= 1;
+        }
+        queue.reset(new QueueSlot[capacity]);
+        for (size_t i = 0; i < capacity; i++) {
+            queue[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        queueMask = capacity - 1;
+
+        // Lines still queued at exit would be lost otherwise
+        std::atexit([]() { Logger::getInstance().enableAsyncMode(false); });
+    }
+
+    writerRunning.store(true, std::memory_order_release);
+    writerThread = std::thread(&Logger::writerLoop, this);
+    asyncMode.store(true, std::memory_order_release);
+}
+
+// Caller holds asyncMutex (or is the destructor)
+void Logger::stopWriter() {
+    asyncMode.store(false, std::memory_order_release);
+    if (!writerThread.joinable()) {
+        return;
+    }
+    writerRunning.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wakeCondition.notify_one();
     }
+    writerThread.join(); // drains the queue before exiting
+}
+
+bool Logger::isAsyncMode() const {
+    return asyncMode.load(std::memory_order_relaxed);
+}
+
+void Logger::setOverflowPolicy(OverflowPolicy policy) {
+    overflowPolicy.store(policy, std::memory_order_relaxed);
+}
+
+uint64_t Logger::getDroppedMessages() const {
+    return droppedMessages.load(std::memory_order_relaxed);
+}
+
+void Logger::flush() {
+    if (asyncMode.load(std::memory_order_acquire)) {
+        uint64_t target = enqueuePos.load(std::memory_order_acquire);
+        wakeWriter();
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        while (writtenPos.load(std::memory_order_acquire) < target && writerRunning.load()) {
+            flushedCondition.wait_for(lock, std::chrono::milliseconds(10));
+        }
+    }
+    std::lock_guard<std::mutex> lock(logMutex);
+    std::cout.flush();
+}
+
+Logger::RateLimiter::RateLimiter(double perSecond, double burst, std::chrono::seconds repeatWindow)
+    : intervalNs(static_cast<int64_t>(1e9 / std::max(perSecond, 1e-9))),
+      burstNs(static_cast<int64_t>((std::max(burst, 1.0) - 1) * (1e9 / std::max(perSecond, 1e-9)))),
+      repeatWindowNs(std::chrono::duration_cast<std::chrono::nanoseconds>(repeatWindow).count()),
+      theoreticalArrival(0), rateSuppressed(0), lastHash(0), lastLoggedNs(0), repeats(0) {}
+
+// GCRA form of a token bucket: a full bucket is an arrival time at or before
+// now, each line pushes it one interval further, and a line is refused once
+// that would put it more than the burst ahead
+bool Logger::RateLimiter::tryAcquire() {
+    int64_t now = steadyNs();
+    int64_t arrival = theoreticalArrival.load(std::memory_order_relaxed);
+    for (;;) {
+        int64_t start = std::max(arrival, now);
+        if (start - now > burstNs) {
+            rateSuppressed.fetch_add(1, std::memory_order_relaxed);
+            Logger::getInstance().suppressedMessages.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (theoreticalArrival.compare_exchange_weak(arrival, start + intervalNs, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+void Logger::RateLimiter::log(ComponentId component, Level level, const std::string& message,
+                              const std::string& module) {
+    auto& logger = Logger::getInstance();
+    uint64_t hash = std::hash<std::string>()(message);
+    int64_t now = steadyNs();
+    if (hash == lastHash.load(std::memory_order_relaxed) &&
+        now - lastLoggedNs.load(std::memory_order_relaxed) < repeatWindowNs) {
+        repeats.fetch_add(1, std::memory_order_relaxed);
+        logger.suppressedMessages.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    lastHash.store(hash, std::memory_order_relaxed);
+    lastLoggedNs.store(now, std::memory_order_relaxed);
+
+    uint64_t repeated = repeats.exchange(0, std::memory_order_relaxed);
+    if (repeated > 0) {
+        logger.log(component, level, "Previous message repeated " + std::to_string(repeated) + " times", module);
+    }
+    uint64_t limited = rateSuppressed.exchange(0, std::memory_order_relaxed);
+    if (limited > 0) {
+        logger.log(component, level, message + " (" + std::to_string(limited) + " similar messages suppressed)",
+                   module);
+    } else {
+        logger.log(component, level, message, module);
+    }
+}
+
+// Date and time down to the second are reformatted only when the second
+// changes (per thread, so no locking); each line just patches in the
+// milliseconds
+size_t Logger::formatTimestamp(char* out) {
+    struct Cache {
+        time_t second = -1;
+        char prefix[kTimestampBufferSize];
+        size_t length = 0;
+    };
+    thread_local Cache cache;
+
+    timespec now;
+#ifdef CLOCK_REALTIME_COARSE
+    clock_gettime(coarseTimestamps.load(std::memory_order_relaxed) ? CLOCK_REALTIME_COARSE : CLOCK_REALTIME, &now);
+#else
+    clock_gettime(CLOCK_REALTIME, &now);
+#endif
+    if (now.tv_sec != cache.second) {
+        std::tm local;
+        localtime_r(&now.tv_sec, &local);
+        cache.length = strftime(cache.prefix, sizeof(cache.prefix), "%Y-%m-%d %H:%M:%S.", &local);
+        cache.second = now.tv_sec;
+    }
+
+    memcpy(out, cache.prefix, cache.length);
+    int ms = static_cast<int>(now.tv_nsec / 1000000);
+    out[cache.length] = static_cast<char>('0' + ms / 100);
+    out[cache.length + 1] = static_cast<char>('0' + ms / 10 % 10);
+    out[cache.length + 2] = static_cast<char>('0' + ms % 10);
+    return cache.length + 3;
 }
 
 std::string Logger::getCurrentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
-
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    ss << "." << std::setfill('0') << std::setw(3) << ms.count();
-    
-    return ss.str();
+    char timestamp[kTimestampBufferSize];
+    return std::string(timestamp, formatTimestamp(timestamp));
+}
+
+void Logger::enableCoarseTimestamps(bool enable) {
+    coarseTimestamps.store(enable, std::memory_order_relaxed);
+}
+
+void Logger::setOutputFormat(OutputFormat format) {
+    outputFormat.store(format, std::memory_order_relaxed);
 }
 
 std::string Logger::levelToString(Level level) {
+    return levelName(level);
+}
+
+const char* Logger::levelName(Level level) {
     switch (level) {
         case Level::DEBUG: return "DEBUG";
         case Level::INFO: return "INFO";
@@ -121,26 +749,457 @@ void Logger::critical(const std::string& message, const std::string& module) {
 
 // Configuration methods
 void Logger::setLogLevel(Level level) {
-    std::lock_guard<std::mutex> lock(logMutex);
-    currentLevel = level;
+    std::lock_guard<std::mutex> lock(levelMutex);
+    currentLevel.store(level, std::memory_order_relaxed);
+    updateComponentLevels();
+}
+
+void Logger::setComponentLevel(const std::string& component, Level level) {
+    ComponentId id = componentId(component);
+    if (id == 0) {
+        std::cerr << "Cannot set log level for component '" << component << "'" << std::endl;
+        return;
+    }
+    std::lock_guard<std::mutex> lock(levelMutex);
+    componentOverrides[id] = static_cast<int>(level);
+    componentLevelsSet.store(true, std::memory_order_relaxed);
+    updateComponentLevels();
+}
+
+void Logger::clearComponentLevel(const std::string& component) {
+    ComponentId id = findComponent(component);
+    if (id == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(levelMutex);
+    componentOverrides[id] = -1;
+    updateComponentLevels();
+}
+
+Logger::ComponentId Logger::findComponent(const std::string& component) const {
+    if (component.empty()) {
+        return 0;
+    }
+    size_t hash = std::hash<std::string>()(component);
+    for (size_t probe = 0; probe < kMaxComponents; probe++) {
+        auto id = static_cast<ComponentId>((hash + probe) % kMaxComponents);
+        if (id == 0) {
+            continue;
+        }
+        const std::string* name = componentNames[id].load(std::memory_order_acquire);
+        if (!name) {
+            return 0;
+        }
+        if (*name == component) {
+            return id;
+        }
+    }
+    return 0;
+}
+
+Logger::ComponentId Logger::componentId(const std::string& component) {
+    ComponentId id = findComponent(component);
+    if (id != 0 || component.empty()) {
+        return id;
+    }
+
+    std::lock_guard<std::mutex> lock(levelMutex);
+    size_t hash = std::hash<std::string>()(component);
+    for (size_t probe = 0; probe < kMaxComponents; probe++) {
+        id = static_cast<ComponentId>((hash + probe) % kMaxComponents);
+        if (id == 0) {
+            continue;
+        }
+        const std::string* name = componentNames[id].load(std::memory_order_relaxed);
+        if (name && *name == component) {
+            return id; // interned meanwhile
+        }
+        if (!name) {
+            // Levels of a free slot already follow the global level
+            componentNames[id].store(new std::string(component), std::memory_order_release);
+            return id;
+        }
+    }
+    return 0; // table full, follows the global level
+}
+
+// Recomputes every slot, used or not, so a newly interned component starts
+// out right. Caller holds levelMutex.
+void Logger::updateComponentLevels() {
+    Level global = currentLevel.load(std::memory_order_relaxed);
+    bool recording = recorderEnabled.load(std::memory_order_relaxed);
+    Level recorded = recordLevel.load(std::memory_order_relaxed);
+    for (size_t id = 0; id < kMaxComponents; id++) {
+        Level written = componentOverrides[id] >= 0 ? static_cast<Level>(componentOverrides[id]) : global;
+        componentWritten[id].store(written, std::memory_order_relaxed);
+        componentEnabled[id].store(recording ? std::min(written, recorded) : written, std::memory_order_relaxed);
+    }
 }
 
 void Logger::setLogFile(const std::string& filename) {
     std::lock_guard<std::mutex> lock(logMutex);
     
-    if (logFile.is_open()) {
-        logFile.close();
+    if (logFd >= 0) {
+        close(logFd);
     }
     
     logFilename = filename;
-    logFile.open(logFilename, std::ios::app);
-    
-    if (!logFile.is_open()) {
-        std::cerr << "Failed to open log file: " << logFilename << std::endl;
+    openLogFile();
+
+    // A successor prepared for the old file is of no use any more
+    std::lock_guard<std::mutex> housekeepingLock(housekeepingMutex);
+    discardPreparedFile();
+    if (rotationPolicy.maxBytes > 0) {
+        prepareFor = logFilename;
+        housekeepingCondition.notify_one();
+    }
+}
+
+void Logger::setRotationPolicy(const RotationPolicy& policy) {
+    std::lock_guard<std::mutex> lock(logMutex);
+    rotationPolicy = policy;
+    if (policy.compress && !compressionAvailable()) {
+        std::cerr << "Log compression requested but zlib is not available" << std::endl;
+        rotationPolicy.compress = false;
+    }
+
+    std::lock_guard<std::mutex> housekeepingLock(housekeepingMutex);
+    prepareBytes = policy.maxBytes;
+    if (policy.maxBytes == 0) {
+        discardPreparedFile(); // no size limit, nothing to preallocate
+    } else if (preparedFd < 0) {
+        prepareFor = logFilename;
+    }
+    if (!housekeepingStarted && (policy.maxBytes > 0 || policy.maxAge.count() > 0)) {
+        std::thread(&Logger::housekeepingLoop, this).detach();
+        housekeepingStarted = true;
+    }
+    housekeepingCondition.notify_one();
+}
+
+bool Logger::compressionAvailable() {
+#ifdef HOTSWAP_HAVE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Caller holds logMutex
+void Logger::rotateIfNeeded(size_t pendingBytes) {
+    if (fileBytes == 0) {
+        return; // never rotate an empty file, whatever its age
+    }
+    bool tooBig = rotationPolicy.maxBytes > 0 && fileBytes + pendingBytes > rotationPolicy.maxBytes;
+    bool tooOld = rotationPolicy.maxAge.count() > 0 &&
+                  std::chrono::steady_clock::now() - fileOpened >= rotationPolicy.maxAge;
+    if (tooBig || tooOld) {
+        rotateLogFile();
+    }
+}
+
+std::string Logger::rotatedFileName() const {
+    time_t now = time(nullptr);
+    std::tm local;
+    localtime_r(&now, &local);
+    char suffix[32];
+    strftime(suffix, sizeof(suffix), ".%Y%m%d-%H%M%S", &local);
+
+    // Fixed-width sequence so names keep sorting by age within a second,
+    // with or without ".gz"
+    std::string name;
+    struct stat info;
+    for (int n = 0; name.empty() || stat(name.c_str(), &info) == 0 || stat((name + ".gz").c_str(), &info) == 0; n++) {
+        char sequence[16];
+        snprintf(sequence, sizeof(sequence), "-%03d", n);
+        name = logFilename + suffix + sequence;
+    }
+    return name;
+}
+
+// Caller holds logMutex. Only renames and an fd swap happen here; the old
+// file is truncated, closed, compressed and pruned in the background.
+void Logger::rotateLogFile() {
+    std::string rotated = rotatedFileName();
+    if (rename(logFilename.c_str(), rotated.c_str()) != 0) {
+        std::cerr << "Failed to rotate log file " << logFilename << ": " << strerror(errno) << std::endl;
+        fileOpened = std::chrono::steady_clock::now(); // retry later, not on every line
+        return;
+    }
+
+    std::lock_guard<std::mutex> housekeepingLock(housekeepingMutex);
+    int oldFd = logFd;
+    logFd = -1;
+    if (preparedFd >= 0 && preparedFor == logFilename &&
+        rename((logFilename + ".next").c_str(), logFilename.c_str()) == 0) {
+        logFd = preparedFd;
+        fileBytes = 0;
+        fileOpened = std::chrono::steady_clock::now();
+    } else {
+        if (preparedFd >= 0) {
+            close(preparedFd);
+        }
+        openLogFile();
+    }
+    preparedFd = -1;
+
+    rotatedFiles.push_back({oldFd, rotated, logFilename, rotationPolicy.keepFiles, rotationPolicy.compress});
+    if (rotationPolicy.maxBytes > 0) {
+        prepareFor = logFilename;
+    }
+    housekeepingCondition.notify_one();
+}
+
+namespace {
+
+#ifdef HOTSWAP_HAVE_ZLIB
+// "<path>.gz" replaces path once it is complete
+bool gzipFile(const std::string& path) {
+    int in = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        return false;
+    }
+    std::string target = path + ".gz";
+    gzFile out = gzopen(target.c_str(), "wb6");
+    bool ok = out != nullptr;
+    char buffer[1 << 16];
+    ssize_t bytes;
+    while (ok && (bytes = read(in, buffer, sizeof(buffer))) > 0) {
+        ok = gzwrite(out, buffer, static_cast<unsigned>(bytes)) == bytes;
+    }
+    ok = ok && bytes == 0;
+    if (out && gzclose(out) != Z_OK) {
+        ok = false;
+    }
+    close(in);
+    unlink(ok ? path.c_str() : target.c_str());
+    return ok;
+}
+#endif
+
+} // namespace
+
+// Rotated files sort by name in age order thanks to the timestamp suffix
+void Logger::pruneRotatedFiles(const std::string& baseName, size_t keepFiles) {
+    size_t slash = baseName.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : baseName.substr(0, slash);
+    std::string prefix = (slash == std::string::npos ? baseName : baseName.substr(slash + 1)) + ".";
+
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) {
+        return;
+    }
+    std::vector<std::string> rotated;
+    while (struct dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.size() > prefix.size() && name.compare(0, prefix.size(), prefix) == 0 &&
+            isdigit(static_cast<unsigned char>(name[prefix.size()]))) {
+            rotated.push_back(name);
+        }
+    }
+    closedir(dir);
+
+    std::sort(rotated.begin(), rotated.end());
+    for (size_t i = 0; i + keepFiles < rotated.size(); i++) {
+        unlink((directory + "/" + rotated[i]).c_str());
+    }
+}
+
+// Caller holds housekeepingMutex
+void Logger::discardPreparedFile() {
+    prepareFor.clear();
+    prepareGeneration++; // one being prepared right now gets deleted instead
+    if (preparedFd >= 0) {
+        close(preparedFd);
+        unlink((preparedFor + ".next").c_str());
+        preparedFd = -1;
+    }
+}
+
+void Logger::housekeepingLoop() {
+    // Compression must not compete with the threads doing real work
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+
+    std::unique_lock<std::mutex> lock(housekeepingMutex);
+    while (true) {
+        housekeepingCondition.wait(lock, [this]() {
+            return !rotatedFiles.empty() || (!prepareFor.empty() && preparedFd < 0);
+        });
+
+        if (!prepareFor.empty() && preparedFd < 0) {
+            // Blocks reserved up front (without growing the file), so the
+            // appends that fill it never wait on block allocation
+            std::string target = prepareFor;
+            uint64_t bytes = prepareBytes;
+            uint64_t generation = prepareGeneration;
+            prepareFor.clear();
+            lock.unlock();
+            std::string path = target + ".next";
+            int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+            if (fd >= 0 && bytes > 0) {
+                fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(bytes));
+            }
+            lock.lock();
+
+            if (generation == prepareGeneration && (prepareFor.empty() || prepareFor == target)) {
+                prepareFor.clear();
+                preparedFd = fd;
+                preparedFor = target;
+            } else if (fd >= 0) {
+                close(fd); // no longer wanted: log file changed or rotation turned off
+                unlink(path.c_str());
+            }
+        }
+
+        if (!rotatedFiles.empty()) {
+            RotatedFile file = rotatedFiles.front();
+            rotatedFiles.pop_front();
+            lock.unlock();
+
+            struct stat info;
+            if (file.fd >= 0) {
+                if (fstat(file.fd, &info) == 0) {
+                    ftruncate(file.fd, info.st_size); // give back unused preallocation
+                }
+                close(file.fd);
+            }
+#ifdef HOTSWAP_HAVE_ZLIB
+            if (file.compress) {
+                gzipFile(file.path);
+            }
+#endif
+            pruneRotatedFiles(file.baseName, file.keepFiles);
+            lock.lock();
+        }
     }
 }
 
 void Logger::enableConsoleOutput(bool enable) {
     std::lock_guard<std::mutex> lock(logMutex);
     consoleOutput = enable;
-}
\ No newline at end of file
+}
+void Logger::enableFlightRecorder(bool enable, size_t entries, Level level) {
+    std::lock_guard<std::mutex> lock(levelMutex);
+    if (enable && !recorder) {
+        size_t capacity = 2;
+        while (capacity < entries) {
+            capacity <<= 1;
+        }
+        recorder.reset(new RecorderSlot[capacity]);
+        for (size_t i = 0; i < capacity; i++) {
+            recorder[i].sequence.store(0, std::memory_order_relaxed);
+            recorder[i].length = 0;
+        }
+        recorderMask = capacity - 1;
+    }
+    recordLevel.store(level, std::memory_order_relaxed);
+    recorderEnabled.store(enable, std::memory_order_release);
+    updateComponentLevels();
+}
+
+// A copy into the slot: no allocation, no lock
+void Logger::recordLine(const std::string& line) {
+    uint64_t pos = recorderPos.fetch_add(1, std::memory_order_relaxed);
+    RecorderSlot& slot = recorder[pos & recorderMask];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    size_t length = std::min(line.size(), sizeof(slot.text));
+    memcpy(slot.text, line.data(), length);
+    slot.length = static_cast<uint32_t>(length);
+    slot.sequence.store(pos + 1, std::memory_order_release);
+}
+
+void Logger::dumpFlightRecorder(int fd) const {
+    if (!recorder) {
+        return;
+    }
+    uint64_t end = recorderPos.load(std::memory_order_acquire);
+    uint64_t capacity = recorderMask + 1;
+    char buffer[4096];
+    size_t used = 0;
+    for (uint64_t pos = end > capacity ? end - capacity : 0; pos < end; pos++) {
+        const RecorderSlot& slot = recorder[pos & recorderMask];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+            continue; // still being written, or already reused
+        }
+        char line[sizeof(slot.text) + 1];
+        size_t length = std::min<size_t>(slot.length, sizeof(slot.text));
+        memcpy(line, slot.text, length);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != pos + 1) {
+            continue; // overwritten while copying
+        }
+        line[length++] = '\n';
+        if (used + length > sizeof(buffer)) {
+            writeAll(fd, buffer, used);
+            used = 0;
+        }
+        memcpy(buffer + used, line, length);
+        used += length;
+    }
+    writeAll(fd, buffer, used);
+}
+
+bool Logger::installCrashHandler(const std::string& dumpPath) {
+    if (dumpPath.empty() || dumpPath.size() >= sizeof(crashDumpPath)) {
+        std::cerr << "Invalid crash dump path: " << dumpPath << std::endl;
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(levelMutex);
+    memcpy(crashDumpPath, dumpPath.c_str(), dumpPath.size() + 1);
+
+    if (!alternateStack.checked) {
+        ensureAlternateStack();
+    }
+
+    struct sigaction action = {};
+    action.sa_handler = &Logger::crashHandler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_ONSTACK;
+    for (int signal : kCrashSignals) {
+        struct sigaction previous;
+        if (sigaction(signal, &action, &previous) != 0) {
+            std::cerr << "Failed to install crash handler for signal " << signal << ": " << strerror(errno) << std::endl;
+            return false;
+        }
+        // Installing twice must not chain the handler to itself
+        if ((previous.sa_flags & SA_SIGINFO) || previous.sa_handler != &Logger::crashHandler) {
+            previousActions[signal] = previous;
+        }
+    }
+    crashHandlerInstalled.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+// Only async-signal-safe calls from here on
+void Logger::crashHandler(int signal) {
+    int savedErrno = errno;
+    if (!crashing) {
+        crashing = 1;
+        int fd = open(crashDumpPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd >= 0) {
+            char number[12];
+            size_t digits = 0;
+            for (int value = signal; value > 0 || digits == 0; value /= 10) {
+                number[sizeof(number) - 1 - digits++] = static_cast<char>('0' + value % 10);
+            }
+            writeText(fd, "=== Flight recorder, signal ");
+            writeAll(fd, number + sizeof(number) - digits, digits);
+            writeText(fd, " ===\n");
+            if (instance) {
+                instance->dumpFlightRecorder(fd);
+            }
+            close(fd);
+            writeText(STDERR_FILENO, "Flight recorder dumped to ");
+            writeText(STDERR_FILENO, crashDumpPath);
+            writeText(STDERR_FILENO, "\n");
+        }
+    }
+
+    // The previous handler (by default: terminate and dump core) takes over
+    // once this one returns
+    sigaction(signal, &previousActions[signal], nullptr);
+    errno = savedErrno;
+    raise(signal);
+}
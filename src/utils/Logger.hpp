@@ -1,10 +1,84 @@
 #pragma once
 #include <string>
-#include <fstream>
 #include <mutex>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <deque>
+#include <initializer_list>
+#include <type_traits>
+
+// Statements below this level are compiled out: 0 DEBUG, 1 INFO, 2 WARNING,
+// 3 ERROR, 4 CRITICAL. Release builds of the core libraries set 1.
+#ifndef HOTSWAP_MIN_LOG_LEVEL
+#define HOTSWAP_MIN_LOG_LEVEL 0
+#endif
+
+// Each call site interns its component once (function-local static), so
+// the component must be the same every time the site runs - a literal.
+#define HOTSWAP_LOG_COMPONENT_(component) \
+    static const Logger::ComponentId hotswapLogComponent = Logger::getInstance().componentId(component)
+
+// Lazy logging: the message expression is only evaluated when the level is
+// enabled for the component, so string building for filtered statements
+// costs nothing.
+//
+//   HOTSWAP_LOG_DEBUG("ModuleManager", "Module stopped: " + moduleName);
+#define HOTSWAP_LOG(level, component, message)                                               \
+    do {                                                                                     \
+        if constexpr (static_cast<int>(level) >= HOTSWAP_MIN_LOG_LEVEL) {                    \
+            HOTSWAP_LOG_COMPONENT_(component);                                               \
+            if (Logger::getInstance().isLevelEnabled(level, hotswapLogComponent)) {          \
+                Logger::getInstance().log(hotswapLogComponent, level, message, component);   \
+            }                                                                                \
+        }                                                                                    \
+    } while (0)
+#define HOTSWAP_LOG_DEBUG(component, message) HOTSWAP_LOG(Logger::Level::DEBUG, component, message)
+#define HOTSWAP_LOG_INFO(component, message) HOTSWAP_LOG(Logger::Level::INFO, component, message)
+#define HOTSWAP_LOG_WARNING(component, message) HOTSWAP_LOG(Logger::Level::WARNING, component, message)
+#define HOTSWAP_LOG_ERROR(component, message) HOTSWAP_LOG(Logger::Level::ERROR, component, message)
+#define HOTSWAP_LOG_CRITICAL(component, message) HOTSWAP_LOG(Logger::Level::CRITICAL, component, message)
+
+// Lazy logging with typed fields, rendered as key=value in text output and
+// as members of the object in JSON output
+//
+//   HOTSWAP_LOG_FIELDS(Logger::Level::INFO, "ModuleManager", "Module loaded",
+//                      {"module", name}, {"load_time_ns", loadTime});
+#define HOTSWAP_LOG_FIELDS(level, component, message, ...)                                           \
+    do {                                                                                             \
+        if constexpr (static_cast<int>(level) >= HOTSWAP_MIN_LOG_LEVEL) {                            \
+            HOTSWAP_LOG_COMPONENT_(component);                                                       \
+            if (Logger::getInstance().isLevelEnabled(level, hotswapLogComponent)) {                  \
+                Logger::getInstance().log(hotswapLogComponent, level, message, component, {__VA_ARGS__}); \
+            }                                                                                        \
+        }                                                                                            \
+    } while (0)
+
+// Rate-limited logging for statements that can repeat without bound. Each
+// call site passes at most `burst` lines at once and `perSecond` after that;
+// the message is not even built for lines over the limit. A line identical
+// to the site's previous one is held back for a minute and counted instead.
+//
+//   HOTSWAP_LOG_LIMITED(Logger::Level::CRITICAL, "HealthMonitor", 5, 20, "Module down: " + name);
+#define HOTSWAP_LOG_LIMITED(level, component, perSecond, burst, message)                        \
+    do {                                                                                        \
+        if constexpr (static_cast<int>(level) >= HOTSWAP_MIN_LOG_LEVEL) {                       \
+            HOTSWAP_LOG_COMPONENT_(component);                                                  \
+            if (Logger::getInstance().isLevelEnabled(level, hotswapLogComponent)) {             \
+                static Logger::RateLimiter hotswapLogLimiter(perSecond, burst);                 \
+                if (hotswapLogLimiter.tryAcquire()) {                                           \
+                    hotswapLogLimiter.log(hotswapLogComponent, level, message, component);      \
+                }                                                                               \
+            }                                                                                   \
+        }                                                                                       \
+    } while (0)
 
 class Logger {
 public:
@@ -17,6 +91,93 @@ public:
         CRITICAL
     };
 
+    // Small ID of an interned component name; 0 is "" and components that
+    // did not fit in the table, which follow the global level
+    using ComponentId = uint16_t;
+    static constexpr size_t kMaxComponents = 256;
+
+    // What a producer does when the async queue is full
+    enum class OverflowPolicy {
+        BLOCK,           // wait until the writer makes room
+        DROP,            // discard the message (counted in getDroppedMessages)
+        DROP_AND_REPORT  // discard, and log how many were lost once there is room
+    };
+
+    // Rotation of the log file. The file is renamed to "<file>.<YYYYmmdd-HHMMSS-NNN>"
+    // and a fresh one (preallocated ahead of time) takes its place.
+    struct RotationPolicy {
+        uint64_t maxBytes = 0;              // rotate before a write would exceed this (0 = no limit)
+        std::chrono::seconds maxAge{0};     // rotate files older than this (0 = no limit)
+        size_t keepFiles = 5;               // rotated files kept, the oldest are deleted
+        bool compress = false;              // gzip rotated files (needs zlib at build time)
+    };
+
+    // How written lines look
+    enum class OutputFormat {
+        TEXT, // [time] [LEVEL] [Component] message key=value ...
+        JSON  // {"ts":...,"level":...,"component":...,"msg":...,<fields>}, one per line
+    };
+
+    // A typed key/value for structured logging. The key and string values
+    // are referenced, not copied: fields only live for the log call.
+    class Field {
+    public:
+        Field(const char* key, const std::string& value) : key(key), type(STRING), text{value.data(), value.size()} {}
+        Field(const char* key, const char* value)
+            : key(key), type(STRING), text{value ? value : "", value ? strlen(value) : 0} {}
+        Field(const char* key, bool value) : key(key), type(BOOL), boolean(value) {}
+        Field(const char* key, double value) : key(key), type(FLOAT), number(value) {}
+        // Durations are logged as integer nanoseconds
+        template <typename Rep, typename Period>
+        Field(const char* key, std::chrono::duration<Rep, Period> value)
+            : key(key), type(INT),
+              integer(std::chrono::duration_cast<std::chrono::nanoseconds>(value).count()) {}
+        template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        Field(const char* key, T value)
+            : key(key), type(std::is_signed<T>::value ? INT : UINT), integer(static_cast<int64_t>(value)) {}
+
+    private:
+        friend class Logger;
+        enum Type : uint8_t { STRING, INT, UINT, FLOAT, BOOL };
+        struct Text {
+            const char* data;
+            size_t length;
+        };
+        const char* key;
+        Type type;
+        union {
+            Text text;
+            int64_t integer; // UINT values are stored bit for bit
+            double number;
+            bool boolean;
+        };
+    };
+
+    // Per call site limits for HOTSWAP_LOG_LIMITED: a token bucket (kept as
+    // a single theoretical arrival time, updated by CAS) and suppression of
+    // repeated lines. All state is atomic, so sites need no lock.
+    class RateLimiter {
+    public:
+        RateLimiter(double perSecond, double burst,
+                    std::chrono::seconds repeatWindow = std::chrono::seconds(60));
+
+        // Takes a token; false (and counted) when the site is over its rate
+        bool tryAcquire();
+        // Logs unless the message repeats the previous one within the
+        // window. Counts of held back lines go out with the next line logged.
+        void log(ComponentId component, Level level, const std::string& message, const std::string& module);
+
+    private:
+        int64_t intervalNs;   // time one token takes to come back
+        int64_t burstNs;      // how far ahead of now the bucket may run
+        int64_t repeatWindowNs;
+        std::atomic<int64_t> theoreticalArrival;
+        std::atomic<uint64_t> rateSuppressed;
+        std::atomic<uint64_t> lastHash;
+        std::atomic<int64_t> lastLoggedNs;
+        std::atomic<uint64_t> repeats;
+    };
+
     // Singleton instance access
     static Logger& getInstance();
 
@@ -26,11 +187,74 @@ public:
     void warning(const std::string& message, const std::string& module = "");
     void error(const std::string& message, const std::string& module = "");
     void critical(const std::string& message, const std::string& module = "");
+    void log(Level level, const std::string& message, const std::string& module);
+    void log(Level level, const std::string& message, const std::string& module,
+             std::initializer_list<Field> fields);
+    // For call sites that interned their component already
+    void log(ComponentId component, Level level, const std::string& message, const std::string& module,
+             std::initializer_list<Field> fields = {});
+
+    // Lets call sites skip building messages that would be filtered anyway.
+    // True for levels the flight recorder keeps even if they are not written.
+    bool isLevelEnabled(Level level, ComponentId component = 0) const {
+        return level >= componentEnabled[component].load(std::memory_order_relaxed);
+    }
+    bool isLevelWritten(Level level, ComponentId component = 0) const {
+        return level >= componentWritten[component].load(std::memory_order_relaxed);
+    }
 
     // Configuration
     void setLogLevel(Level level);
+    // Per-component levels, keyed by the module argument of the log calls.
+    // They override setLogLevel() for that component and take effect
+    // immediately, without taking the log lock.
+    void setComponentLevel(const std::string& component, Level level);
+    void clearComponentLevel(const std::string& component);
+    // Interns a component name (once per name; lock-free once known)
+    ComponentId componentId(const std::string& component);
     void setLogFile(const std::string& filename);
     void enableConsoleOutput(bool enable);
+    // Timestamps from CLOCK_REALTIME_COARSE: never reads the hardware clock,
+    // so it stays cheap where the clocksource makes clock_gettime a syscall,
+    // but only has tick resolution (typically 1-4ms)
+    void enableCoarseTimestamps(bool enable);
+    // Text or JSON lines; the same call sites produce either. Lines are
+    // encoded into a per-thread buffer that is reused, so formatting does
+    // not allocate once it has grown to the thread's longest line.
+    void setOutputFormat(OutputFormat format);
+
+    // Async mode: callers only format the line and push it onto a lock-free
+    // queue; a writer thread batches queued lines into writev calls. The
+    // queue capacity (rounded up to a power of two) is fixed by the first
+    // enable. Disabling drains the queue; it is also disabled at exit.
+    void enableAsyncMode(bool enable, size_t queueCapacity = 8192);
+    bool isAsyncMode() const;
+    void setOverflowPolicy(OverflowPolicy policy);
+    uint64_t getDroppedMessages() const;
+    // Lines held back by HOTSWAP_LOG_LIMITED sites, rate or repeats
+    uint64_t getSuppressedMessages() const { return suppressedMessages.load(std::memory_order_relaxed); }
+
+    // Returns once everything logged before the call has been written out
+    void flush();
+
+    // Rotation runs where lines are written (the writer thread in async
+    // mode), so producers never wait on it; preallocating the next file,
+    // compressing and pruning happen on a low-priority background thread
+    void setRotationPolicy(const RotationPolicy& policy);
+    static bool compressionAvailable();
+
+    // Flight recorder: the last `entries` lines from recordLevel up (DEBUG
+    // by default, whatever the log level) are kept in a fixed in-memory ring
+    // and never reach disk unless dumped. The ring size is fixed by the first
+    // enable. installCrashHandler() dumps it to dumpPath on SIGSEGV, SIGABRT,
+    // SIGBUS, SIGFPE and SIGILL, then hands the signal to the previous handler.
+    // Statements below HOTSWAP_MIN_LOG_LEVEL are compiled out and never recorded.
+    // Threads get an alternate signal stack on their first log line after
+    // that, so a stack overflow on a logging thread is dumped too.
+    void enableFlightRecorder(bool enable, size_t entries = 2048, Level recordLevel = Level::DEBUG);
+    bool installCrashHandler(const std::string& dumpPath);
+    // Writes the ring to fd, oldest line first; async-signal-safe
+    void dumpFlightRecorder(int fd) const;
 
     // Prevent copying
     Logger(const Logger&) = delete;
@@ -40,17 +264,120 @@ private:
     Logger();
     ~Logger();
 
-    void log(Level level, const std::string& message, const std::string& module);
+    struct QueueSlot {
+        std::atomic<uint64_t> sequence;
+        Level level;
+        std::string line;
+    };
+
+    // 256 bytes per recorded line, longer lines are cut
+    struct RecorderSlot {
+        std::atomic<uint64_t> sequence; // position + 1 once written, 0 while being written
+        uint32_t length;
+        char text[244];
+    };
+
+    static constexpr size_t kTimestampBufferSize = 32;
+
     std::string levelToString(Level level);
+    static const char* levelName(Level level);
     std::string getCurrentTimestamp();
+    size_t formatTimestamp(char* out);
     std::string getColorCode(Level level);
     std::string getResetColor();
 
+    void openLogFile();
+    void writeLine(Level level, const std::string& line);
+    bool enqueue(Level level, std::string& line);
+    void wakeWriter();
+    void writerLoop();
+    size_t writeQueuedBatch();
+    void stopWriter();
+
+    void formatLine(std::string& out, Level level, const std::string& message, const std::string& module,
+                    std::initializer_list<Field> fields);
+    static void appendJsonString(std::string& out, const char* text, size_t length);
+    static void appendFieldValue(std::string& out, const Field& field, bool json);
+    void recordLine(const std::string& line);
+    ComponentId findComponent(const std::string& component) const;
+    void updateComponentLevels();
+    static void crashHandler(int signal);
+
+    void rotateIfNeeded(size_t pendingBytes);
+    void rotateLogFile();
+    std::string rotatedFileName() const;
+    void housekeepingLoop();
+    void pruneRotatedFiles(const std::string& baseName, size_t keepFiles);
+    void discardPreparedFile();
+
     // Member variables
     static Logger* instance;
-    std::ofstream logFile;
+    int logFd;
     std::mutex logMutex;
-    Level currentLevel;
+    std::atomic<Level> currentLevel;
+
+    // Component filter table, indexed by ComponentId. Names sit in an open
+    // addressed hash table where the slot index is the ID; they are only
+    // added (under levelMutex) and never removed, so lookups need no lock.
+    std::atomic<const std::string*> componentNames[kMaxComponents];
+    std::atomic<Level> componentEnabled[kMaxComponents]; // lowest level reaching log(), recorder included
+    std::atomic<Level> componentWritten[kMaxComponents]; // lowest level written out
+    int componentOverrides[kMaxComponents];              // -1 follows currentLevel; levelMutex
+    std::atomic<bool> componentLevelsSet;                // any override ever set
     bool consoleOutput;
+    std::atomic<bool> coarseTimestamps;
+    std::atomic<OutputFormat> outputFormat;
     std::string logFilename;
-};
\ No newline at end of file
+
+    // Async queue - bounded MPSC ring, slots carry a sequence number so
+    // producers claim them with a single CAS and never wait on each other
+    std::unique_ptr<QueueSlot[]> queue;
+    size_t queueMask;
+    alignas(64) std::atomic<uint64_t> enqueuePos;
+    alignas(64) uint64_t dequeuePos; // writer thread only
+    std::atomic<uint64_t> writtenPos;
+    std::atomic<uint64_t> droppedMessages;
+    std::atomic<uint64_t> suppressedMessages;
+    uint64_t reportedDrops; // writer thread only
+    std::atomic<OverflowPolicy> overflowPolicy;
+    std::atomic<bool> asyncMode;
+    std::atomic<bool> writerRunning;
+    std::atomic<bool> writerSleeping;
+    std::thread writerThread;
+    std::mutex asyncMutex; // enable/disable
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable flushedCondition;
+
+    // Flight recorder - slots are claimed with one fetch_add and written
+    // seqlock style, so a dump skips lines that are still being written
+    std::unique_ptr<RecorderSlot[]> recorder; // never freed, the crash handler reads it
+    size_t recorderMask;
+    alignas(64) std::atomic<uint64_t> recorderPos;
+    std::atomic<bool> recorderEnabled;
+    std::atomic<Level> recordLevel;
+    std::mutex levelMutex; // levels, component table and enableFlightRecorder
+
+    // Rotation - state of the current file is guarded by logMutex
+    RotationPolicy rotationPolicy;
+    uint64_t fileBytes;
+    std::chrono::steady_clock::time_point fileOpened;
+
+    // Background housekeeping, guarded by housekeepingMutex (taken after logMutex)
+    struct RotatedFile {
+        int fd;           // still open; truncated to its size before closing
+        std::string path;
+        std::string baseName;
+        size_t keepFiles;
+        bool compress;
+    };
+    std::mutex housekeepingMutex;
+    std::condition_variable housekeepingCondition;
+    std::deque<RotatedFile> rotatedFiles;
+    std::string prepareFor;  // log file that needs a preallocated successor
+    uint64_t prepareBytes;
+    int preparedFd;          // "<preparedFor>.next", ready to take over
+    std::string preparedFor;
+    uint64_t prepareGeneration; // bumped when a successor in preparation is no longer wanted
+    bool housekeepingStarted; // detached, lives as long as the process
+};
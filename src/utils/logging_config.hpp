@@ -8,6 +8,22 @@ public:
         logger.setLogLevel(Logger::Level::INFO);
         logger.setLogFile("/var/log/hotswap_system.log");
         logger.enableConsoleOutput(false); // In production, log to file only
+        logger.setOverflowPolicy(Logger::OverflowPolicy::DROP_AND_REPORT);
+        logger.enableAsyncMode(true); // Callers never wait on disk I/O
+
+        Logger::RotationPolicy rotation;
+        rotation.maxBytes = 100ull * 1024 * 1024;
+        rotation.maxAge = std::chrono::hours(24);
+        rotation.keepFiles = 14;
+        rotation.compress = Logger::compressionAvailable();
+        logger.setRotationPolicy(rotation);
+
+        // Debug-level context for crashes without writing debug lines to disk.
+        // Release builds of the core libraries compile HOTSWAP_LOG_DEBUG out
+        // (HOTSWAP_MIN_LOG_LEVEL), so there the ring only gets DEBUG lines
+        // from code built without that floor.
+        logger.enableFlightRecorder(true);
+        logger.installCrashHandler("/var/log/hotswap_crash.log");
     }
     
     static void setupDevelopmentLogging() {
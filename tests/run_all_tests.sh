@@ -107,6 +107,36 @@ echo "Test 3.6: Stress Testing"
 ./test_stress > /dev/null 2>&1
 print_result $? "System stability under stress"
 
+# Test 3.7: Isolated Module Hosting
+echo ""
+echo "Test 3.7: Isolated Module Hosting"
+./test_isolated_module > /dev/null 2>&1
+print_result $? "Worker process isolation and crash restart"
+
+# Test 3.8: Health Monitor
+echo ""
+echo "Test 3.8: Health Monitor"
+./test_health_monitor > /dev/null 2>&1
+print_result $? "Health reporting and monitoring"
+
+# Test 3.9: Latency Histograms
+echo ""
+echo "Test 3.9: Latency Histograms"
+./test_latency_histogram > /dev/null 2>&1
+print_result $? "HDR latency histogram accuracy"
+
+# Test 3.10: Metrics Exporter
+echo ""
+echo "Test 3.10: Metrics Exporter"
+./test_metrics_exporter > /dev/null 2>&1
+print_result $? "OpenMetrics exposition over unix socket and loopback"
+
+# Test 3.11: Logger
+echo ""
+echo "Test 3.11: Logger"
+./test_logger > /dev/null 2>&1
+print_result $? "Async logging, ordering and overflow policies"
+
 # Memory Leak Tests
 echo ""
 echo "4. MEMORY LEAK TESTING"
@@ -0,0 +1,682 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <unistd.h>
+#include "../src/core/HealthMonitor.hpp"
+#include "../src/core/ModuleManager.hpp"
+
+using HealthStatus = HealthMonitor::HealthStatus;
+
+// Polls until the module reaches the expected status or the timeout expires
+bool waitForStatus(const std::string& moduleName, HealthStatus expected,
+                   std::chrono::milliseconds timeout = std::chrono::milliseconds(3000)) {
+    auto& monitor = HealthMonitor::getInstance();
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (monitor.getModuleHealth(moduleName).status == expected) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+void test_heartbeat_reporting() {
+    std::cout << "Testing Heartbeat Health Reporting..." << std::endl;
+
+    auto& monitor = HealthMonitor::getInstance();
+    monitor.setFailureThreshold(1000);
+    monitor.setCheckInterval(std::chrono::milliseconds(50));
+
+    HeartbeatSlot* slot = monitor.registerHeartbeatModule("HeartbeatModule");
+    assert(slot != nullptr && "No heartbeat slot assigned");
+    assert(reinterpret_cast<uintptr_t>(slot) % 64 == 0 && "Heartbeat slot not cache-line aligned");
+
+    slot->beat(HeartbeatSlot::UNHEALTHY);
+    monitor.startMonitoring();
+    assert(waitForStatus("HeartbeatModule", HealthStatus::UNHEALTHY) && "Unhealthy beat not picked up");
+    std::cout << "✓ Unhealthy heartbeat detected" << std::endl;
+
+    slot->beat(HeartbeatSlot::DEGRADED, 90);
+    assert(waitForStatus("HeartbeatModule", HealthStatus::DEGRADED) && "Degraded beat not picked up");
+    std::cout << "✓ Degraded heartbeat detected" << std::endl;
+
+    slot->beat(HeartbeatSlot::HEALTHY);
+    assert(waitForStatus("HeartbeatModule", HealthStatus::HEALTHY) && "Healthy beat not picked up");
+    std::cout << "✓ Recovery detected" << std::endl;
+
+    // Stop beating - staleness turns the module unhealthy
+    monitor.setHeartbeatTimeout(std::chrono::milliseconds(50));
+    assert(waitForStatus("HeartbeatModule", HealthStatus::UNHEALTHY) && "Missed heartbeat not detected");
+    std::cout << "✓ Missed heartbeat detected" << std::endl;
+    monitor.setHeartbeatTimeout(std::chrono::milliseconds(0));
+
+    monitor.unregisterModule("HeartbeatModule");
+
+    // Calculator V2 opts into push-based health through ModuleManager
+    auto& manager = ModuleManager::getInstance();
+    bool loaded = manager.loadModule("./calculator_v2.so");
+    assert(loaded && "Failed to load calculator_v2");
+    (void)loaded;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(3000);
+    while (monitor.getModuleHealth("Calculator").message != "Heartbeat healthy" &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    assert(monitor.getModuleHealth("Calculator").message == "Heartbeat healthy" &&
+           "Module heartbeat not attached");
+    std::cout << "✓ Module publishes health through its heartbeat slot" << std::endl;
+
+    // The outgoing module's stop() must not reach the slot during a hot-swap
+    monitor.setCheckInterval(std::chrono::milliseconds(1));
+    for (int i = 0; i < 300; i++) {
+        bool swapped = manager.reloadModule("Calculator");
+        assert(swapped && "Reload failed");
+        (void)swapped;
+    }
+    for (const auto& sample : monitor.getHealthHistory("Calculator").recent) {
+        assert(sample.status != static_cast<uint8_t>(HealthStatus::UNHEALTHY) &&
+               "Stopping module published into its heartbeat slot");
+        (void)sample;
+    }
+    monitor.setCheckInterval(std::chrono::milliseconds(50));
+    std::cout << "✓ Hot-swap detaches the heartbeat before stop" << std::endl;
+    manager.unloadModule("Calculator");
+
+    monitor.stopMonitoring();
+
+    std::cout << "Heartbeat Test: PASSED" << std::endl;
+}
+
+void test_check_scheduling() {
+    std::cout << "Testing Per-Module Check Scheduling..." << std::endl;
+
+    auto& monitor = HealthMonitor::getInstance();
+    monitor.setCheckInterval(std::chrono::seconds(10));
+
+    std::atomic<int> fastChecks{0};
+    std::atomic<int> slowChecks{0};
+    monitor.setModuleCheckInterval("FastModule", std::chrono::milliseconds(20));
+    monitor.registerModule("FastModule", [&fastChecks]() { fastChecks++; return true; });
+    monitor.registerModule("SlowModule", [&slowChecks]() { slowChecks++; return true; });
+
+    monitor.startMonitoring();
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    assert(fastChecks >= 10 && "Per-module interval not honoured");
+    assert(slowChecks <= 1 && "Default interval not honoured");
+    std::cout << "✓ Fast module checked " << fastChecks << " times, slow module " << slowChecks << std::endl;
+
+    // Stopping must not wait out the 10s interval
+    auto stopStart = std::chrono::steady_clock::now();
+    monitor.stopMonitoring();
+    auto stopTime = std::chrono::steady_clock::now() - stopStart;
+    assert(stopTime < std::chrono::milliseconds(500) && "stopMonitoring blocked on the interval");
+    std::cout << "✓ Monitoring stopped immediately" << std::endl;
+
+    monitor.unregisterModule("FastModule");
+    monitor.unregisterModule("SlowModule");
+
+    std::cout << "Scheduling Test: PASSED" << std::endl;
+}
+
+void test_check_deadlines() {
+    std::cout << "Testing Parallel Checks With Deadlines..." << std::endl;
+
+    auto& monitor = HealthMonitor::getInstance();
+    monitor.setCheckInterval(std::chrono::milliseconds(20));
+    monitor.setCheckTimeout(std::chrono::milliseconds(100));
+
+    std::atomic<bool> releaseHungCheck{false};
+    std::atomic<int> responsiveChecks{0};
+    monitor.registerModule("HungModule", [&releaseHungCheck]() {
+        while (!releaseHungCheck) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return true;
+    });
+    monitor.registerModule("ResponsiveModule", [&responsiveChecks]() { responsiveChecks++; return true; });
+
+    monitor.startMonitoring();
+    assert(waitForStatus("HungModule", HealthStatus::UNHEALTHY, std::chrono::milliseconds(1000)) &&
+           "Hung check not marked unhealthy at its deadline");
+    std::cout << "✓ Hung check marked unhealthy at deadline" << std::endl;
+
+    // The hung check must not block readers or other modules' checks
+    auto readStart = std::chrono::steady_clock::now();
+    monitor.getModuleHealth("ResponsiveModule");
+    assert(std::chrono::steady_clock::now() - readStart < std::chrono::milliseconds(50) &&
+           "getModuleHealth blocked behind a hung check");
+    (void)readStart;
+    int before = responsiveChecks;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    assert(responsiveChecks > before && "Other checks stalled behind the hung one");
+    (void)before;
+    assert(monitor.getModuleHealth("ResponsiveModule").status == HealthStatus::HEALTHY);
+    std::cout << "✓ Other modules keep being checked" << std::endl;
+
+    releaseHungCheck = true;
+    assert(waitForStatus("HungModule", HealthStatus::HEALTHY) && "Module did not recover after hang");
+    std::cout << "✓ Module recovers once its check returns" << std::endl;
+
+    monitor.stopMonitoring();
+    monitor.unregisterModule("HungModule");
+    monitor.unregisterModule("ResponsiveModule");
+    monitor.setCheckTimeout(std::chrono::milliseconds(1000));
+
+    // Pool checks run module code without the manager's lock; unload and
+    // hot-swap must not free the module or its library under them
+    auto& manager = ModuleManager::getInstance();
+    monitor.setCheckInterval(std::chrono::milliseconds(1));
+    monitor.startMonitoring();
+    for (int i = 0; i < 50; i++) {
+        bool loaded = manager.loadModule("./calculator_v1.so");
+        assert(loaded && "Failed to load calculator_v1");
+        bool swapped = manager.reloadModule("Calculator");
+        assert(swapped && "Reload under running checks failed");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        bool unloaded = manager.unloadModule("Calculator");
+        assert(unloaded && "Unload under running checks failed");
+        (void)loaded;
+        (void)swapped;
+        (void)unloaded;
+    }
+    monitor.stopMonitoring();
+    monitor.setCheckInterval(std::chrono::milliseconds(20));
+    std::cout << "✓ Unload and hot-swap wait for in-flight checks" << std::endl;
+
+    std::cout << "Deadline Test: PASSED" << std::endl;
+}
+
+void test_concurrent_metrics() {
+    std::cout << "Testing Per-Thread Metrics Counters..." << std::endl;
+
+    auto& monitor = HealthMonitor::getInstance();
+    auto id = monitor.getModuleId("CountedModule");
+    assert(id != HealthMonitor::kInvalidModuleId);
+    assert(monitor.getModuleId("CountedModule") == id && "Module ID not stable");
+
+    // Short-lived threads exercise counter block reuse
+    for (int round = 0; round < 2; round++) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&monitor, id]() {
+                for (int i = 0; i < 10000; i++) {
+                    monitor.recordModuleLoad(id, std::chrono::microseconds(100));
+                    monitor.recordHotSwap(id, i % 10 != 0, std::chrono::microseconds(200));
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    auto metrics = monitor.getModuleMetrics("CountedModule");
+    assert(metrics.totalLoads == 80000 && "Lost load counts");
+    assert(metrics.totalHotSwaps == 80000 && "Lost hot-swap counts");
+    assert(metrics.failedOperations == 8000 && "Lost failure counts");
+    assert(metrics.averageLoadTime > std::chrono::microseconds(95) &&
+           metrics.averageLoadTime < std::chrono::microseconds(105));
+    std::cout << "✓ Counts exact across threads" << std::endl;
+
+    // Counters are cumulative across unregister/re-register (reloads)
+    monitor.registerModule("CountedModule", []() { return true; });
+    monitor.unregisterModule("CountedModule");
+    monitor.recordModuleUnload("CountedModule");
+    metrics = monitor.getModuleMetrics("CountedModule");
+    assert(metrics.totalLoads == 80000 && metrics.totalUnloads == 1 && "Counters reset on re-register");
+    std::cout << "✓ Counters survive re-registration" << std::endl;
+
+    std::cout << "Metrics Test: PASSED" << std::endl;
+}
+
+void test_remediation() {
+    std::cout << "Testing Automatic Remediation..." << std::endl;
+
+    auto& monitor = HealthMonitor::getInstance();
+    using Action = HealthMonitor::RemediationAction;
+    monitor.setCheckInterval(std::chrono::milliseconds(20));
+    monitor.setFailureThreshold(2);
+
+    HealthMonitor::RemediationPolicy policy;
+    policy.initialBackoff = std::chrono::milliseconds(30);
+    policy.maxBackoff = std::chrono::milliseconds(1000);
+    policy.backoffMultiplier = 2.0;
+    policy.budget = 3;
+    policy.budgetWindow = std::chrono::seconds(10);
+    policy.circuitOpenTime = std::chrono::milliseconds(300);
+    policy.stableTime = std::chrono::milliseconds(100);
+    monitor.setRemediationPolicy(policy);
+
+    std::mutex attemptsMutex;
+    std::vector<std::pair<Action, std::chrono::steady_clock::time_point>> attempts;
+    std::atomic<bool> fixed{false};
+    monitor.setRemediationHandler([&](const std::string& moduleName, Action action) {
+        assert(moduleName == "FlakyModule");
+        (void)moduleName;
+        std::lock_guard<std::mutex> lock(attemptsMutex);
+        attempts.emplace_back(action, std::chrono::steady_clock::now());
+        return fixed.load();
+    });
+    auto attemptCount = [&]() {
+        std::lock_guard<std::mutex> lock(attemptsMutex);
+        return attempts.size();
+    };
+    auto waitForAttempts = [&](size_t count, std::chrono::milliseconds timeout) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (attemptCount() < count && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return attemptCount() >= count;
+    };
+
+    monitor.registerModule("FlakyModule", [&fixed]() { return fixed.load(); });
+    monitor.startMonitoring();
+
+    bool attempted = waitForAttempts(3, std::chrono::milliseconds(3000));
+    assert(attempted && "Remediation never attempted");
+    {
+        std::lock_guard<std::mutex> lock(attemptsMutex);
+        assert(attempts[0].first == Action::RESTART_INSTANCE);
+        assert(attempts[1].first == Action::RELOAD_LIBRARY);
+        assert(attempts[2].first == Action::ROLLBACK);
+        assert(attempts[1].second - attempts[0].second >= std::chrono::milliseconds(30));
+        assert(attempts[2].second - attempts[1].second >= std::chrono::milliseconds(60) && "Backoff not growing");
+    }
+    std::cout << "✓ Escalates restart -> reload -> rollback with backoff" << std::endl;
+
+    // Budget of 3 exhausted - the breaker holds off further attempts
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    assert(attemptCount() == 3 && "Circuit breaker did not stop attempts");
+    assert(monitor.getRemediationStatus("FlakyModule").circuitOpen);
+    std::cout << "✓ Circuit opens once the budget is spent" << std::endl;
+
+    // After the open period a single trial is allowed
+    attempted = waitForAttempts(4, std::chrono::milliseconds(2000));
+    assert(attempted && "No half-open trial");
+    (void)attempted;
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    assert(attemptCount() == 4 && "More than one half-open trial");
+    std::cout << "✓ Half-open allows exactly one trial" << std::endl;
+
+    // Module recovers and stays healthy - escalation and breaker reset
+    fixed = true;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    while ((monitor.getRemediationStatus("FlakyModule").attempts != 0 ||
+            monitor.getRemediationStatus("FlakyModule").circuitOpen) &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    auto status = monitor.getRemediationStatus("FlakyModule");
+    assert(status.attempts == 0 && !status.circuitOpen && "Remediation not reset after recovery");
+    (void)status;
+    std::cout << "✓ Stable module resets remediation state" << std::endl;
+
+    monitor.stopMonitoring();
+    monitor.setRemediationHandler(nullptr);
+    monitor.unregisterModule("FlakyModule");
+    monitor.setFailureThreshold(1000);
+
+    // The actions ModuleManager performs for the handler
+    auto& manager = ModuleManager::getInstance();
+    bool loaded = manager.loadModule("./calculator_v1.so");
+    assert(loaded && "Failed to load calculator_v1");
+    (void)loaded;
+    bool swapped = manager.swapModule("Calculator", "./calculator_v2.so");
+    assert(swapped && manager.getModuleInfo("Calculator").version == "2.0.0");
+    (void)swapped;
+    assert(manager.getModuleInfo("Calculator").previousLibraryPath == "./calculator_v1.so");
+    swapped = manager.swapModule("Calculator", "./missing_calculator.so");
+    assert(!swapped && manager.getModuleInfo("Calculator").version == "2.0.0" && "Failed swap not restored");
+    assert(manager.getModuleInfo("Calculator").previousLibraryPath == "./calculator_v1.so" &&
+           "Restored module lost its rollback target");
+    bool restarted = manager.restartModule("Calculator");
+    assert(restarted && manager.getModuleInfo("Calculator").version == "2.0.0");
+    (void)restarted;
+    bool rolledBack = manager.rollbackModule("Calculator");
+    assert(rolledBack && manager.getModuleInfo("Calculator").version == "1.0.0" && "Rollback failed");
+    (void)rolledBack;
+    std::cout << "✓ Restart, swap and rollback through ModuleManager" << std::endl;
+
+    // Restarts run outside the manager's lock; swaps wait for them instead
+    // of freeing the instance underneath
+    std::thread restarter([&manager]() {
+        for (int i = 0; i < 50; i++) {
+            manager.restartModule("Calculator");
+        }
+    });
+    for (int i = 0; i < 20; i++) {
+        swapped = manager.reloadModule("Calculator");
+        assert(swapped && "Reload during restarts failed");
+        assert(manager.getModule("Calculator") != nullptr);
+    }
+    restarter.join();
+    assert(manager.getModuleInfo("Calculator").isRunning && "Module left stopped after restarts");
+    manager.unloadModule("Calculator");
+    std::cout << "✓ Restarts and hot-swaps interleave safely" << std::endl;
+
+    std::cout << "Remediation Test: PASSED" << std::endl;
+}
+
+void test_adaptive_checks() {
+    std::cout << "Testing Adaptive Check Frequency..." << std::endl;
+
+    auto& monitor = HealthMonitor::getInstance();
+    monitor.setCheckInterval(std::chrono::milliseconds(20));
+    HealthMonitor::AdaptiveCheckPolicy policy;
+    policy.stableChecks = 2;
+    policy.growth = 2.0;
+    policy.maxFactor = 8.0;
+    policy.minFactor = 0.25;
+    monitor.setAdaptiveCheckPolicy(policy);
+
+    std::mutex timesMutex;
+    std::vector<std::chrono::steady_clock::time_point> checkTimes;
+    std::atomic<bool> failing{false};
+    monitor.registerModule("AdaptiveModule", [&]() {
+        std::lock_guard<std::mutex> lock(timesMutex);
+        checkTimes.push_back(std::chrono::steady_clock::now());
+        return !failing.load();
+    });
+    auto lastGap = [&]() {
+        std::lock_guard<std::mutex> lock(timesMutex);
+        size_t n = checkTimes.size();
+        return n < 2 ? std::chrono::steady_clock::duration::zero() : checkTimes[n - 1] - checkTimes[n - 2];
+    };
+
+    monitor.startMonitoring();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    assert(lastGap() > std::chrono::milliseconds(100) && "Stable module interval not stretched");
+    std::cout << "✓ Stable module stretched to ~" 
+              << std::chrono::duration_cast<std::chrono::milliseconds>(lastGap()).count() << "ms" << std::endl;
+
+    failing = true;
+    assert(waitForStatus("AdaptiveModule", HealthStatus::UNHEALTHY) && "Failure not detected");
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    assert(lastGap() < std::chrono::milliseconds(20) && "Failing module interval not tightened");
+    std::cout << "✓ Failing module tightened" << std::endl;
+
+    auto stats = monitor.getCheckStats();
+    assert(stats.detections >= 1 && stats.checkIntervalAtDetection.totalCount >= 1);
+    assert(stats.checkIntervalAtDetection.maxNs < 1000000000ull && "Check interval at detection beyond the stretched interval");
+    std::cout << "✓ Check interval at detection p99 " << stats.checkIntervalAtDetection.p99() / 1000000 << "ms" << std::endl;
+
+    monitor.stopMonitoring();
+    monitor.unregisterModule("AdaptiveModule");
+
+    // Global budget: 20 modules at 10ms would be 2000 checks/s
+    policy.enabled = false;
+    monitor.setAdaptiveCheckPolicy(policy);
+    monitor.setCheckInterval(std::chrono::milliseconds(10));
+    monitor.setCheckBudget(100);
+    std::atomic<int> budgetedChecks{0};
+    for (int i = 0; i < 20; i++) {
+        monitor.registerModule("BudgetModule" + std::to_string(i), [&budgetedChecks]() {
+            budgetedChecks++;
+            return true;
+        });
+    }
+    uint64_t deferredBefore = monitor.getCheckStats().checksDeferred;
+    monitor.startMonitoring();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1200));
+    int checksInWindow = budgetedChecks;
+    stats = monitor.getCheckStats();
+    monitor.stopMonitoring();
+
+    assert(checksInWindow <= 100 * 1.2 + 20 && "Check budget exceeded"); // 1.2s plus the 100ms burst
+    assert(checksInWindow >= 60 && "Budget starved the checks");
+    assert(stats.checksDeferred > deferredBefore && "Nothing deferred under budget");
+    (void)deferredBefore;
+    assert(stats.achievedChecksPerSecond > 0 && stats.achievedChecksPerSecond <= 130);
+    std::cout << "✓ Budget held at " << stats.achievedChecksPerSecond << " checks/s (" << checksInWindow
+              << " checks in 1.2s)" << std::endl;
+
+    for (int i = 0; i < 20; i++) {
+        monitor.unregisterModule("BudgetModule" + std::to_string(i));
+    }
+    monitor.setCheckBudget(0);
+    policy.enabled = true;
+    monitor.setAdaptiveCheckPolicy(policy);
+
+    std::cout << "Adaptive Check Test: PASSED" << std::endl;
+}
+
+void test_latency_degradation() {
+    std::cout << "Testing Latency-Based Degradation..." << std::endl;
+
+    auto& monitor = HealthMonitor::getInstance();
+    monitor.setCheckInterval(std::chrono::milliseconds(10));
+    LatencyBaseline::Policy policy;
+    policy.warmupSamples = 20;
+    policy.minDriftNs = 1000000; // 1ms above baseline
+    monitor.setDegradationPolicy(policy);
+
+    std::atomic<int> checkDelayUs{200};
+    monitor.registerModule("SlowingModule", [&checkDelayUs]() {
+        std::this_thread::sleep_for(std::chrono::microseconds(checkDelayUs.load()));
+        return true;
+    });
+    monitor.startMonitoring();
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (monitor.getLatencyBaseline("SlowingModule", HealthMonitor::BaselineKind::HEALTH_CHECK).samples < 25 &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    assert(monitor.getModuleHealth("SlowingModule").status == HealthStatus::HEALTHY);
+
+    checkDelayUs = 20000; // well clear of warmup noise on a loaded machine
+    assert(waitForStatus("SlowingModule", HealthStatus::DEGRADED) && "Slow checks not flagged DEGRADED");
+    assert(monitor.getModuleHealth("SlowingModule").message.find("latency degraded") != std::string::npos);
+    std::cout << "✓ 100x slower checks flagged DEGRADED" << std::endl;
+
+    checkDelayUs = 200;
+    assert(waitForStatus("SlowingModule", HealthStatus::HEALTHY) && "No recovery from DEGRADED");
+    std::cout << "✓ Recovers when latency returns to baseline" << std::endl;
+
+    // A new version that is legitimately slower: re-registering (as a hot
+    // swap does) starts a fresh baseline instead of staying DEGRADED
+    checkDelayUs = 20000;
+    assert(waitForStatus("SlowingModule", HealthStatus::DEGRADED));
+    monitor.registerModule("SlowingModule", [&checkDelayUs]() {
+        std::this_thread::sleep_for(std::chrono::microseconds(checkDelayUs.load()));
+        return true;
+    });
+    assert(monitor.getLatencyBaseline("SlowingModule", HealthMonitor::BaselineKind::HEALTH_CHECK).samples < 5);
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (monitor.getLatencyBaseline("SlowingModule", HealthMonitor::BaselineKind::HEALTH_CHECK).samples < 25 &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    assert(monitor.getModuleHealth("SlowingModule").status == HealthStatus::HEALTHY &&
+           "Swapped-in version judged against the old baseline");
+    std::cout << "✓ Re-registration resets the learned baseline" << std::endl;
+
+    monitor.stopMonitoring();
+    monitor.unregisterModule("SlowingModule");
+
+    std::cout << "Degradation Test: PASSED" << std::endl;
+}
+
+void test_system_health_aggregation() {
+    std::cout << "Testing Incremental System Health..." << std::endl;
+
+    auto& monitor = HealthMonitor::getInstance();
+    monitor.setCheckInterval(std::chrono::milliseconds(10));
+    monitor.setFailureThreshold(2);
+    assert(monitor.getSystemHealth() == HealthStatus::UNHEALTHY && "No modules should read UNHEALTHY");
+
+    // Readiness-probe style readers hammer the lock-free getter throughout
+    std::atomic<bool> stopReaders{false};
+    std::atomic<uint64_t> reads{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 2; t++) {
+        readers.emplace_back([&]() {
+            while (!stopReaders) {
+                monitor.getSystemHealth();
+                reads++;
+            }
+        });
+    }
+
+    std::atomic<bool> failing{false};
+    monitor.registerModule("SteadyModule", []() { return true; });
+    monitor.registerModule("FlakyModule", [&failing]() { return !failing.load(); });
+    assert(monitor.getModuleCount(HealthStatus::HEALTHY) == 2);
+    assert(monitor.getSystemHealth() == HealthStatus::HEALTHY);
+    monitor.startMonitoring();
+
+    failing = true;
+    assert(waitForStatus("FlakyModule", HealthStatus::CRITICAL) && "Failing module not CRITICAL");
+    assert(monitor.getSystemHealth() == HealthStatus::CRITICAL);
+    assert(monitor.getModuleCount(HealthStatus::CRITICAL) == 1);
+    assert(monitor.getModuleCount(HealthStatus::HEALTHY) == 1);
+    std::cout << "✓ CRITICAL module drives system health" << std::endl;
+
+    failing = false;
+    assert(waitForStatus("FlakyModule", HealthStatus::HEALTHY) && "Module did not recover");
+    assert(monitor.getSystemHealth() == HealthStatus::HEALTHY);
+    assert(monitor.getModuleCount(HealthStatus::CRITICAL) == 0);
+    std::cout << "✓ Counts follow recovery" << std::endl;
+
+    monitor.stopMonitoring();
+    monitor.unregisterModule("SteadyModule");
+    monitor.unregisterModule("FlakyModule");
+    assert(monitor.getModuleCount(HealthStatus::HEALTHY) == 0 && "Unregister left a count behind");
+    assert(monitor.getSystemHealth() == HealthStatus::UNHEALTHY);
+
+    stopReaders = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    std::cout << "✓ " << reads << " concurrent lock-free reads" << std::endl;
+
+    std::cout << "System Health Test: PASSED" << std::endl;
+}
+
+void test_health_history() {
+    std::cout << "Testing Health History..." << std::endl;
+
+    const int64_t minuteNs = 60ll * 1000000000ll;
+    const int64_t baseNs = 1000 * 60 * minuteNs; // on an hour boundary
+    auto sample = [](int64_t timeNs, float responseMs, HealthStatus status) {
+        HealthSample s{};
+        s.timeNs = timeNs;
+        s.responseTimeMs = responseMs;
+        s.status = static_cast<uint8_t>(status);
+        return s;
+    };
+
+    {
+        HealthHistory history;
+        // 300 results one second apart: five minute buckets, one hour bucket
+        for (int i = 0; i < 300; i++) {
+            HealthStatus status = (i % 100 == 99) ? HealthStatus::UNHEALTHY : HealthStatus::HEALTHY;
+            history.record("Mod", sample(baseNs + i * 1000000000ll, static_cast<float>(i % 60), status));
+        }
+        HealthHistoryView view = history.get("Mod");
+        assert(view.recent.size() == HealthHistory::kRecentSamples && "Recent ring not bounded");
+        assert(view.recent.front().timeNs == baseNs + 44 * 1000000000ll && "Oldest sample not evicted first");
+        assert(view.recent.back().timeNs == baseNs + 299 * 1000000000ll);
+        assert(view.minutes.size() == 5);
+        assert(view.minutes[0].samples == 60 && view.minutes[0].startNs == baseNs);
+        assert(view.minutes[0].minResponseMs == 0.0f && view.minutes[0].maxResponseMs == 59.0f);
+        assert(view.minutes[0].meanResponseMs() == 29.5);
+        assert(view.minutes[1].failures == 1 && view.minutes[1].statusChanges == 2);
+        assert(view.minutes[1].worstStatus == static_cast<uint32_t>(HealthStatus::UNHEALTHY));
+        assert(view.hours.size() == 1);
+        assert(view.hours[0].samples == 300 && view.hours[0].failures == 3);
+        assert(view.hours[0].statusChanges == 5 && "Last failure has no recovery yet");
+        assert(history.get("Unknown").recent.empty());
+        std::cout << "✓ Recent ring and minute/hour rollups" << std::endl;
+
+        // Minute rollups wrap after two hours of buckets
+        for (int i = 0; i < 200; i++) {
+            history.record("Mod", sample(baseNs + (10 + i) * minuteNs, 1.0f, HealthStatus::HEALTHY));
+        }
+        view = history.get("Mod");
+        assert(view.minutes.size() == HealthHistory::kMinuteRollups);
+        assert(view.minutes.back().startNs == baseNs + 209 * minuteNs);
+        assert(view.hours.size() == 4);
+        std::cout << "✓ Rollup rings stay bounded" << std::endl;
+    }
+
+    std::string path = "/tmp/hotswap_history_" + std::to_string(getpid()) + ".bin";
+    unlink(path.c_str());
+    {
+        HealthHistory history;
+        history.record("Persisted", sample(baseNs, 5.0f, HealthStatus::HEALTHY));
+        bool attached = history.attachFile(path);
+        assert(attached && "Could not back history by a file");
+        (void)attached;
+        history.record("Persisted", sample(baseNs + minuteNs, 7.0f, HealthStatus::DEGRADED));
+    }
+    {
+        HealthHistory history;
+        bool attached = history.attachFile(path);
+        assert(attached);
+        (void)attached;
+        HealthHistoryView view = history.get("Persisted");
+        assert(view.recent.size() == 2 && "History not restored from file");
+        assert(view.recent[1].responseTimeMs == 7.0f);
+        assert(view.minutes.size() == 2 && view.hours[0].statusChanges == 1);
+    }
+    unlink(path.c_str());
+    std::cout << "✓ History survives a restart" << std::endl;
+
+    // Results of monitored modules land in the monitor's history
+    auto& monitor = HealthMonitor::getInstance();
+    monitor.setCheckInterval(std::chrono::milliseconds(10));
+    monitor.setFailureThreshold(1);
+    std::atomic<bool> failing{false};
+    monitor.registerModule("HistoryModule", [&failing]() { return !failing.load(); });
+    monitor.startMonitoring();
+    while (monitor.getHealthHistory("HistoryModule").recent.empty()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5)); // a healthy result first
+    }
+    failing = true;
+    bool down = waitForStatus("HistoryModule", HealthStatus::CRITICAL);
+    assert(down);
+    (void)down;
+    failing = false;
+    bool recovered = waitForStatus("HistoryModule", HealthStatus::HEALTHY);
+    assert(recovered);
+    (void)recovered;
+    monitor.stopMonitoring();
+    monitor.unregisterModule("HistoryModule");
+
+    HealthHistoryView view = monitor.getHealthHistory("HistoryModule");
+    assert(!view.recent.empty() && !view.minutes.empty());
+    uint32_t changes = 0, failures = 0;
+    for (const HealthRollup& bucket : view.minutes) {
+        changes += bucket.statusChanges;
+        failures += bucket.failures;
+    }
+    assert(changes >= 2 && failures >= 1 && "Flapping not visible in history");
+    std::cout << "✓ Monitor records check results (" << view.recent.size() << " samples)" << std::endl;
+
+    std::cout << "Health History Test: PASSED" << std::endl;
+}
+
+int main() {
+    try {
+        test_heartbeat_reporting();
+        test_check_scheduling();
+        test_check_deadlines();
+        test_concurrent_metrics();
+        test_remediation();
+        test_adaptive_checks();
+        test_latency_degradation();
+        test_system_health_aggregation();
+        test_health_history();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test FAILED: " << e.what() << std::endl;
+        return 1;
+    }
+}
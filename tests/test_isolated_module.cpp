@@ -0,0 +1,98 @@
+#include <iostream>
+#include <cassert>
+#include <csignal>
+#include <string>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../src/core/ModuleManager.hpp"
+#include "../src/core/IsolatedModule.hpp"
+
+// Host-side IPC channels open in this process, and how many are close-on-exec
+void countChannels(int& open, int& closeOnExec) {
+    open = closeOnExec = 0;
+    DIR* fds = opendir("/proc/self/fd");
+    while (dirent* entry = fds ? readdir(fds) : nullptr) {
+        char target[256];
+        std::string link = std::string("/proc/self/fd/") + entry->d_name;
+        ssize_t length = readlink(link.c_str(), target, sizeof(target) - 1);
+        if (length <= 0 || std::string(target, length).find("memfd:hotswap_ipc") == std::string::npos) {
+            continue;
+        }
+        open++;
+        closeOnExec += (fcntl(atoi(entry->d_name), F_GETFD) & FD_CLOEXEC) ? 1 : 0;
+    }
+    if (fds) {
+        closedir(fds);
+    }
+}
+
+void test_isolated_module() {
+    std::cout << "Testing Isolated Module Hosting..." << std::endl;
+
+    auto& manager = ModuleManager::getInstance();
+
+    // Load one module in-process and one in a worker process
+    bool result = manager.loadModule("./calculator_v1.so");
+    assert(result && "Failed to load in-process module");
+    result = manager.loadModuleIsolated("./simple_module.so");
+    assert(result && "Failed to load isolated module");
+    std::cout << "✓ Isolated module loaded alongside in-process module" << std::endl;
+
+    auto info = manager.getModuleInfo("SimpleModule");
+    assert(info.name == "SimpleModule" && "Wrong module name");
+    assert(info.version == "1.0" && "Wrong module version");
+    assert(info.isolated && "Module not marked isolated");
+    std::cout << "✓ Module information reported through worker" << std::endl;
+
+    auto* isolated = dynamic_cast<IsolatedModule*>(manager.getModule("SimpleModule"));
+    assert(isolated != nullptr && "Module is not an IsolatedModule proxy");
+    assert(isolated->isHealthy() && "Isolated module not healthy");
+    std::cout << "✓ Health check round-trips through IPC" << std::endl;
+
+    int channels = 0, closeOnExec = 0;
+    countChannels(channels, closeOnExec);
+    assert(channels == 1 && closeOnExec == 1 && "IPC channel would leak into other spawned processes");
+    std::cout << "✓ IPC channel is close-on-exec in the host" << std::endl;
+
+    // Simulate a module crash - only the worker dies
+    pid_t oldPid = isolated->getWorkerPid();
+    kill(oldPid, SIGKILL);
+    bool healthDuringCrash = isolated->isHealthy();
+    assert(!healthDuringCrash && "Crashed call should report failure");
+    (void)healthDuringCrash;
+    assert(isolated->getRestartCount() == 1 && "Worker was not restarted");
+    assert(isolated->getWorkerPid() != oldPid && "Worker pid did not change");
+
+    // Replayed init + start: SimpleModule is only healthy while running
+    assert(isolated->isHealthy() && "Restarted worker not healthy");
+    std::cout << "✓ Crashed worker restarted and init replayed" << std::endl;
+
+    auto* calculator = manager.getModule("Calculator");
+    assert(calculator != nullptr && calculator->isHealthy() && "In-process module affected by crash");
+    (void)calculator;
+    std::cout << "✓ Other modules unaffected" << std::endl;
+
+    result = manager.reloadModule("SimpleModule");
+    assert(result && "Failed to hot-swap isolated module");
+    assert(manager.getModuleInfo("SimpleModule").isolated && "Hot-swap lost isolation");
+    std::cout << "✓ Isolated module hot-swapped" << std::endl;
+
+    result = manager.unloadModule("SimpleModule");
+    assert(result && "Failed to unload isolated module");
+    (void)result;
+    manager.unloadModule("Calculator");
+    std::cout << "✓ Modules unloaded successfully" << std::endl;
+
+    std::cout << "Isolated Module Test: PASSED" << std::endl;
+}
+
+int main() {
+    try {
+        test_isolated_module();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test FAILED: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,112 @@
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "../src/core/LatencyHistogram.hpp"
+
+// Within the histogram's ~3% relative error
+bool closeTo(uint64_t actual, uint64_t expected) {
+    double error = std::abs(static_cast<double>(actual) - static_cast<double>(expected));
+    return error <= expected * 0.035 + 1;
+}
+
+void test_bucket_layout() {
+    std::cout << "Testing Bucket Layout..." << std::endl;
+
+    size_t previous = 0;
+    for (uint64_t value = 0; value < (1ull << 20); value++) {
+        size_t index = LatencyHistogram::bucketIndex(value);
+        assert(index >= previous && "Bucket index not monotonic");
+        assert(value <= LatencyHistogram::bucketUpperBound(index) && "Value above its bucket bound");
+        previous = index;
+    }
+    (void)previous;
+    assert(LatencyHistogram::bucketIndex(~0ull) == LatencyHistogram::kBucketCount - 1 &&
+           "Huge values must clamp into the last bucket");
+    std::cout << "✓ Buckets are contiguous and monotonic" << std::endl;
+}
+
+void test_percentiles() {
+    std::cout << "Testing Percentiles..." << std::endl;
+
+    LatencyHistogram histogram;
+    for (uint64_t i = 1; i <= 100000; i++) {
+        histogram.record(i * 100); // 100ns .. 10ms
+    }
+
+    auto snapshot = histogram.snapshot();
+    assert(snapshot.totalCount == 100000);
+    assert(snapshot.minNs == 100 && snapshot.maxNs == 10000000);
+    assert(closeTo(snapshot.p50(), 5000000) && "p50 out of range");
+    assert(closeTo(snapshot.p99(), 9900000) && "p99 out of range");
+    assert(closeTo(snapshot.p999(), 9990000) && "p999 out of range");
+    std::cout << "✓ p50=" << snapshot.p50() << "ns p99=" << snapshot.p99()
+              << "ns p999=" << snapshot.p999() << "ns" << std::endl;
+
+    // Sub-microsecond values are resolved, not rounded to zero
+    LatencyHistogram fast;
+    fast.record(250);
+    assert(closeTo(fast.snapshot().p50(), 250) && "Sub-microsecond value lost");
+    std::cout << "✓ Sub-microsecond resolution" << std::endl;
+}
+
+void test_merge_and_reset() {
+    std::cout << "Testing Merge And Interval Reset..." << std::endl;
+
+    LatencyHistogram a;
+    LatencyHistogram b;
+    for (int i = 0; i < 1000; i++) {
+        a.record(1000);
+        b.record(1000000);
+    }
+
+    auto merged = a.snapshot();
+    merged.merge(b.snapshot());
+    assert(merged.totalCount == 2000);
+    assert(merged.minNs == 1000 && merged.maxNs == 1000000);
+    assert(closeTo(merged.percentile(25), 1000) && closeTo(merged.percentile(75), 1000000));
+    std::cout << "✓ Snapshots merge" << std::endl;
+
+    auto interval = a.snapshotAndReset();
+    assert(interval.totalCount == 1000);
+    (void)interval;
+    assert(a.snapshot().totalCount == 0 && "Interval reset left counts behind");
+    a.record(42);
+    assert(a.snapshot().minNs == 42 && a.snapshot().maxNs == 42);
+    std::cout << "✓ Interval reset starts a clean window" << std::endl;
+}
+
+void test_concurrent_recording() {
+    std::cout << "Testing Concurrent Recording..." << std::endl;
+
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&histogram, t]() {
+            for (int i = 0; i < 50000; i++) {
+                histogram.record(static_cast<uint64_t>(t * 1000 + i % 1000));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    assert(histogram.snapshot().totalCount == 200000 && "Lost updates under contention");
+    std::cout << "✓ No lost updates" << std::endl;
+}
+
+int main() {
+    try {
+        test_bucket_layout();
+        test_percentiles();
+        test_merge_and_reset();
+        test_concurrent_recording();
+        std::cout << "Latency Histogram Test: PASSED" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test FAILED: " << e.what() << std::endl;
+        return 1;
+    }
+}
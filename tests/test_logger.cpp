@@ -0,0 +1,1014 @@
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <limits>
+#include <new>
+#include <csignal>
+#include <cstdlib>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef HOTSWAP_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#include "../src/utils/Logger.hpp"
+#include "../src/utils/BinaryLog.hpp"
+
+// Counts heap allocations made by the current thread while enabled
+thread_local bool countAllocations = false;
+thread_local size_t allocationCount = 0;
+
+// Kept out of line, like operator delete below, so GCC does not pair the
+// inlined malloc with a sized delete and flag them as mismatched
+__attribute__((noinline)) void* operator new(size_t size) {
+    if (countAllocations) {
+        allocationCount++;
+    }
+    void* memory = malloc(size ? size : 1);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+// Kept out of line, otherwise GCC flags the inlined free() as mismatched
+__attribute__((noinline)) void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+__attribute__((noinline)) void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+namespace {
+
+const int kThreads = 4;
+
+std::string logPath(const std::string& name) {
+    return "/tmp/hotswap_logger_" + std::to_string(getpid()) + "_" + name + ".log";
+}
+
+std::vector<std::string> readLines(const std::string& path) {
+    std::vector<std::string> lines;
+    std::ifstream in(path);
+    for (std::string line; std::getline(in, line);) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// Lines look like "[ts] [INFO] [LoggerTest] T<thread> <seq>"
+bool parseMessage(const std::string& line, int& thread, int& sequence) {
+    size_t at = line.find("] T");
+    return at != std::string::npos && sscanf(line.c_str() + at + 3, "%d %d", &thread, &sequence) == 2;
+}
+
+void logFromThreads(int perThread) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++) {
+        threads.emplace_back([t, perThread]() {
+            auto& logger = Logger::getInstance();
+            for (int i = 0; i < perThread; i++) {
+                logger.info("T" + std::to_string(t) + " " + std::to_string(i), "LoggerTest");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void logLimitedRepeat(const std::string& message) {
+    HOTSWAP_LOG_LIMITED(Logger::Level::INFO, "LoggerTest", 1000, 1000, message);
+}
+
+} // namespace
+
+void test_sync_logging() {
+    std::cout << "Testing Synchronous Logging..." << std::endl;
+
+    auto& logger = Logger::getInstance();
+    std::string path = logPath("sync");
+    logger.setLogFile(path);
+    logger.info("T0 0", "LoggerTest");
+    logger.debug("T0 1", "LoggerTest"); // below INFO
+    logger.warning("T0 2");
+
+    // No flush needed: every line is already written to the file
+    std::vector<std::string> lines = readLines(path);
+    assert(lines.size() == 2 && "DEBUG line should be filtered");
+    assert(lines[0].find("[INFO] [LoggerTest] T0 0") != std::string::npos);
+    assert(lines[1].find("[WARNING] T0 2") != std::string::npos);
+    unlink(path.c_str());
+    std::cout << "✓ Lines reach the file immediately" << std::endl;
+}
+
+void test_async_logging() {
+    std::cout << "Testing Async Logging..." << std::endl;
+
+    auto& logger = Logger::getInstance();
+    std::string path = logPath("async");
+    logger.setLogFile(path);
+    logger.setOverflowPolicy(Logger::OverflowPolicy::BLOCK);
+    logger.enableAsyncMode(true, 64); // small queue so producers do hit a full ring
+    assert(logger.isAsyncMode());
+
+    const int perThread = 5000;
+    logFromThreads(perThread);
+    logger.flush();
+
+    std::vector<std::string> lines = readLines(path);
+    assert(lines.size() == static_cast<size_t>(kThreads * perThread) && "BLOCK must not lose lines");
+    std::vector<int> next(kThreads, 0);
+    for (const std::string& line : lines) {
+        int thread = -1, sequence = -1;
+        bool parsed = parseMessage(line, thread, sequence);
+        assert(parsed && thread >= 0 && thread < kThreads && "Corrupted line");
+        (void)parsed;
+        assert(sequence == next[thread] && "Lines of one thread out of order");
+        next[thread]++;
+    }
+    assert(logger.getDroppedMessages() == 0);
+    std::cout << "✓ " << lines.size() << " lines from " << kThreads << " threads, in order per thread" << std::endl;
+
+    // Lines logged after flush() returned are not lost by disabling either
+    logger.info("T0 " + std::to_string(perThread), "LoggerTest");
+    logger.enableAsyncMode(false);
+    assert(!logger.isAsyncMode());
+    lines = readLines(path);
+    assert(lines.size() == static_cast<size_t>(kThreads * perThread + 1) && "Disable must drain the queue");
+    unlink(path.c_str());
+    std::cout << "✓ Disabling drains the queue" << std::endl;
+}
+
+void test_overflow_policies() {
+    std::cout << "Testing Overflow Policies..." << std::endl;
+
+    auto& logger = Logger::getInstance();
+    const int perThread = 20000;
+
+    std::string path = logPath("drop");
+    logger.setLogFile(path);
+    logger.setOverflowPolicy(Logger::OverflowPolicy::DROP);
+    logger.enableAsyncMode(true);
+    uint64_t droppedBefore = logger.getDroppedMessages();
+    logFromThreads(perThread);
+    logger.flush();
+    uint64_t dropped = logger.getDroppedMessages() - droppedBefore;
+    std::vector<std::string> lines = readLines(path);
+    assert(lines.size() + dropped == static_cast<size_t>(kThreads * perThread) && "Every line written or counted");
+    unlink(path.c_str());
+    std::cout << "✓ DROP: " << lines.size() << " written, " << dropped << " counted as dropped" << std::endl;
+
+    path = logPath("report");
+    logger.setLogFile(path);
+    logger.setOverflowPolicy(Logger::OverflowPolicy::DROP_AND_REPORT);
+    droppedBefore = logger.getDroppedMessages();
+    logFromThreads(perThread);
+    logger.enableAsyncMode(false); // writer drains and reports before exiting
+    dropped = logger.getDroppedMessages() - droppedBefore;
+
+    size_t messages = 0;
+    uint64_t reported = 0;
+    for (const std::string& line : readLines(path)) {
+        int thread, sequence;
+        unsigned long long count;
+        size_t at = line.find("[Logger] ");
+        if (at != std::string::npos && sscanf(line.c_str() + at + 9, "%llu log messages dropped", &count) == 1) {
+            reported += count;
+        } else if (parseMessage(line, thread, sequence)) {
+            messages++;
+        }
+    }
+    assert(messages + dropped == static_cast<size_t>(kThreads * perThread));
+    assert(reported == dropped && "Drops not reported in the log");
+    unlink(path.c_str());
+    std::cout << "✓ DROP_AND_REPORT: " << reported << " drops reported in the log" << std::endl;
+
+    logger.setOverflowPolicy(Logger::OverflowPolicy::BLOCK);
+    std::cout << "Overflow Policy Test: PASSED" << std::endl;
+}
+
+namespace {
+
+// Built before the thread's first binary record, so destroyed after its ring
+// has been retired
+struct ExitLine {
+    ~ExitLine() { HOTSWAP_LOG_FMT(Logger::Level::INFO, "LoggerTest", "thread exit {}", 1); }
+};
+
+} // namespace
+
+void test_binary_log() {
+    std::cout << "Testing Binary Log..." << std::endl;
+
+    auto& logger = Logger::getInstance();
+    auto& binaryLog = BinaryLog::getInstance();
+
+    // Closed: call sites fall back to formatted text
+    std::string textPath = logPath("fallback");
+    logger.setLogFile(textPath);
+    HOTSWAP_LOG_FMT(Logger::Level::INFO, "LoggerTest", "Loaded {} v{} in {}ms ({}, {}, {}, {})",
+                    std::string("Calc"), "2.0", 42, -7, 1.5, true, 'x');
+    HOTSWAP_LOG_FMT(Logger::Level::DEBUG, "LoggerTest", "filtered {}", 1);
+    std::vector<std::string> lines = readLines(textPath);
+    assert(lines.size() == 1 && "Fallback should log once, DEBUG filtered");
+    assert(lines[0].find("[INFO] [LoggerTest] Loaded Calc v2.0 in 42ms (-7, 1.5, true, x)") != std::string::npos);
+    unlink(textPath.c_str());
+    std::cout << "✓ Text fallback renders the same format" << std::endl;
+
+    std::string binaryPath = logPath("binary");
+    bool opened = binaryLog.open(binaryPath);
+    assert(opened && binaryLog.isOpen());
+
+    const int perThread = 2000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < perThread; i++) {
+                HOTSWAP_LOG_FMT(Logger::Level::INFO, "LoggerTest", "T{} {} {}", t, i, std::string("module"));
+                if (i % 500 == 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2)); // let the writer keep up
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Cost per call while the ring has room
+    const int timed = 1000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < timed; i++) {
+        HOTSWAP_LOG_FMT(Logger::Level::INFO, "LoggerTest", "timed {} {}", i, std::string("Calculator"));
+    }
+    auto nsPerCall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count() / timed;
+    binaryLog.close();
+    assert(!binaryLog.isOpen());
+    uint64_t dropped = binaryLog.getDroppedRecords();
+
+    std::string command = "./hotswap_log_decoder " + binaryPath;
+    FILE* decoder = popen(command.c_str(), "r");
+    assert(decoder && "Cannot run hotswap_log_decoder");
+    std::vector<int> next(kThreads, 0);
+    size_t decoded = 0, timedLines = 0;
+    char buffer[512];
+    while (fgets(buffer, sizeof(buffer), decoder)) {
+        std::string line(buffer);
+        int thread = -1, sequence = -1;
+        if (line.find("[INFO] [LoggerTest] timed ") != std::string::npos) {
+            timedLines++;
+            continue;
+        }
+        bool parsed = parseMessage(line, thread, sequence);
+        assert(parsed && thread >= 0 && thread < kThreads && "Decoded line malformed");
+        (void)parsed;
+        assert(line.find("[INFO] [LoggerTest] T") != std::string::npos);
+        assert(line.find(" module\n") != std::string::npos && "String argument lost");
+        assert(sequence >= next[thread] && "Thread's records out of order");
+        next[thread] = sequence + 1;
+        decoded++;
+    }
+    int status = pclose(decoder);
+    assert(status == 0 && "Decoder failed");
+    assert(decoded + timedLines + dropped == static_cast<size_t>(kThreads * perThread + timed) &&
+           "Every record decoded or counted as dropped");
+    unlink(binaryPath.c_str());
+    std::cout << "✓ " << decoded + timedLines << " records decoded (" << dropped << " dropped), "
+              << nsPerCall << " ns per binary log call" << std::endl;
+
+    // Closing under load: every record lands in the file, in the text log or
+    // in the dropped count; none is stranded in a ring
+    std::string racePath = logPath("binary-race");
+    std::string raceTextPath = logPath("binary-race-text");
+    logger.setLogFile(raceTextPath);
+    uint64_t droppedBefore = binaryLog.getDroppedRecords();
+    opened = binaryLog.open(racePath);
+    assert(opened);
+    (void)opened;
+    std::atomic<int> logged{0};
+    std::atomic<bool> stop{false};
+    threads.clear();
+    for (int t = 0; t < kThreads; t++) {
+        threads.emplace_back([&logged, &stop]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                HOTSWAP_LOG_FMT(Logger::Level::INFO, "LoggerTest", "race {}", 1);
+                logged.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    binaryLog.close();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    stop.store(true);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    logger.flush();
+    size_t raceText = 0;
+    for (const std::string& line : readLines(raceTextPath)) {
+        raceText += line.find("[LoggerTest] race 1") != std::string::npos;
+    }
+    size_t raceBinary = 0;
+    command = "./hotswap_log_decoder " + racePath;
+    decoder = popen(command.c_str(), "r");
+    assert(decoder && "Cannot run hotswap_log_decoder");
+    while (fgets(buffer, sizeof(buffer), decoder)) {
+        raceBinary += std::string(buffer).find("[LoggerTest] race 1") != std::string::npos;
+    }
+    status = pclose(decoder);
+    assert(status == 0 && "Decoder failed");
+    (void)status;
+    assert(raceBinary + raceText + (binaryLog.getDroppedRecords() - droppedBefore) ==
+           static_cast<size_t>(logged.load()) && "Record lost while closing");
+    (void)droppedBefore;
+    logger.setLogFile(logPath("idle"));
+    unlink(racePath.c_str());
+    unlink(raceTextPath.c_str());
+    std::cout << "✓ Close waits for in-flight records" << std::endl;
+
+    // A line logged from a thread_local destructor after the thread's ring is
+    // retired must not touch the ring (the writer may already have freed it)
+    std::string exitPath = logPath("binary-exit");
+    std::string exitTextPath = logPath("binary-exit-text");
+    logger.setLogFile(exitTextPath);
+    opened = binaryLog.open(exitPath);
+    assert(opened);
+    std::thread exiting([]() {
+        static thread_local ExitLine exitLine;
+        (void)&exitLine;
+        HOTSWAP_LOG_FMT(Logger::Level::INFO, "LoggerTest", "before exit {}", 1);
+    });
+    exiting.join();
+    binaryLog.close();
+    logger.flush();
+    bool exitLineInText = false;
+    for (const std::string& line : readLines(exitTextPath)) {
+        exitLineInText |= line.find("[LoggerTest] thread exit 1") != std::string::npos;
+    }
+    assert(exitLineInText && "Line after ring retirement not sent to text");
+    (void)exitLineInText;
+    logger.setLogFile(logPath("idle"));
+    unlink(exitPath.c_str());
+    unlink(exitTextPath.c_str());
+    std::cout << "✓ Lines after thread-exit cleanup fall back to text" << std::endl;
+
+    std::cout << "Binary Log Test: PASSED" << std::endl;
+}
+
+namespace {
+
+int evaluations = 0;
+
+std::string expensiveMessage() {
+    evaluations++;
+    return "expensive";
+}
+
+} // namespace
+
+void test_lazy_logging() {
+    std::cout << "Testing Lazy Logging..." << std::endl;
+
+    auto& logger = Logger::getInstance();
+    std::string path = logPath("lazy");
+    logger.setLogFile(path);
+    logger.setLogLevel(Logger::Level::INFO);
+
+    evaluations = 0;
+    HOTSWAP_LOG_DEBUG("LoggerTest", expensiveMessage());
+    HOTSWAP_LOG_FMT(Logger::Level::DEBUG, "LoggerTest", "{}", expensiveMessage());
+    assert(evaluations == 0 && "Filtered statements must not evaluate their message");
+    HOTSWAP_LOG_INFO("LoggerTest", expensiveMessage());
+    assert(evaluations == 1);
+
+    logger.setLogLevel(Logger::Level::DEBUG);
+    HOTSWAP_LOG_DEBUG("LoggerTest", expensiveMessage());
+    assert(evaluations == 2 && "Runtime level change not honoured");
+    std::cout << "✓ Messages built only when the level is enabled" << std::endl;
+
+    // As a release build of the core libraries sees it
+#undef HOTSWAP_MIN_LOG_LEVEL
+#define HOTSWAP_MIN_LOG_LEVEL 1
+    HOTSWAP_LOG_DEBUG("LoggerTest", expensiveMessage());
+    HOTSWAP_LOG_FMT(Logger::Level::DEBUG, "LoggerTest", "{}", expensiveMessage());
+    HOTSWAP_LOG_WARNING("LoggerTest", expensiveMessage());
+#undef HOTSWAP_MIN_LOG_LEVEL
+#define HOTSWAP_MIN_LOG_LEVEL 0
+    assert(evaluations == 3 && "DEBUG statements must be compiled out");
+    logger.setLogLevel(Logger::Level::INFO);
+
+    std::vector<std::string> lines = readLines(path);
+    assert(lines.size() == 3);
+    assert(lines[0].find("[INFO] [LoggerTest] expensive") != std::string::npos);
+    assert(lines[1].find("[DEBUG] [LoggerTest] expensive") != std::string::npos);
+    assert(lines[2].find("[WARNING] [LoggerTest] expensive") != std::string::npos);
+    unlink(path.c_str());
+    std::cout << "✓ Compile-time minimum level strips DEBUG" << std::endl;
+
+    std::cout << "Lazy Logging Test: PASSED" << std::endl;
+}
+
+namespace {
+
+// Seconds since the epoch of a line's "[YYYY-mm-dd HH:MM:SS.mmm]" prefix, -1 if malformed
+time_t lineTime(const std::string& line, int& milliseconds) {
+    std::tm local{};
+    char dot = 0, close = 0;
+    if (line.size() < 25 ||
+        sscanf(line.c_str(), "[%4d-%2d-%2d %2d:%2d:%2d%c%3d%c", &local.tm_year, &local.tm_mon, &local.tm_mday,
+               &local.tm_hour, &local.tm_min, &local.tm_sec, &dot, &milliseconds, &close) != 9 ||
+        dot != '.' || close != ']' || line[24] != ']') {
+        return -1;
+    }
+    local.tm_year -= 1900;
+    local.tm_mon -= 1;
+    local.tm_isdst = -1;
+    return mktime(&local);
+}
+
+} // namespace
+
+void test_timestamps() {
+    std::cout << "Testing Timestamps..." << std::endl;
+
+    auto& logger = Logger::getInstance();
+    for (bool coarse : {false, true}) {
+        std::string path = logPath(coarse ? "coarse" : "precise");
+        logger.setLogFile(path);
+        logger.enableCoarseTimestamps(coarse);
+        time_t before = time(nullptr);
+        for (int i = 0; i < 200; i++) {
+            logger.info("tick", "LoggerTest");
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+        time_t after = time(nullptr);
+
+        std::vector<std::string> lines = readLines(path);
+        assert(lines.size() == 200);
+        std::vector<bool> seenMs(1000, false);
+        size_t distinctMs = 0;
+        time_t previous = before;
+        for (const std::string& line : lines) {
+            int milliseconds = -1;
+            time_t seconds = lineTime(line, milliseconds);
+            assert(seconds >= previous && seconds <= after && "Timestamp outside the logging window");
+            assert(milliseconds >= 0 && milliseconds < 1000);
+            previous = seconds;
+            if (!seenMs[milliseconds]) {
+                seenMs[milliseconds] = true;
+                distinctMs++;
+            }
+        }
+        (void)after;
+        (void)previous;
+        assert(distinctMs > 10 && "Millisecond suffix not updated per line");
+        std::cout << "✓ " << (coarse ? "Coarse" : "Precise") << " clock: " << distinctMs
+                  << " distinct milliseconds over 200 lines" << std::endl;
+        unlink(path.c_str());
+    }
+    logger.enableCoarseTimestamps(false);
+
+    std::cout << "Timestamp Test: PASSED" << std::endl;
+}
+
+namespace {
+
+std::vector<std::string> listDirectory(const std::string& directory) {
+    std::vector<std::string> names;
+    if (DIR* dir = opendir(directory.c_str())) {
+        while (struct dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] != '.') {
+                names.push_back(entry->d_name);
+            }
+        }
+        closedir(dir);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+// Rotated files of app.log, oldest first
+std::vector<std::string> rotatedFiles(const std::string& directory) {
+    std::vector<std::string> rotated;
+    for (const std::string& name : listDirectory(directory)) {
+        if (name.compare(0, 8, "app.log.") == 0 && name != "app.log.next") {
+            rotated.push_back(name);
+        }
+    }
+    return rotated;
+}
+
+std::vector<std::string> readMaybeCompressed(const std::string& path) {
+    if (path.size() < 3 || path.compare(path.size() - 3, 3, ".gz") != 0) {
+        return readLines(path);
+    }
+    std::vector<std::string> lines;
+#ifdef HOTSWAP_HAVE_ZLIB
+    gzFile in = gzopen(path.c_str(), "rb");
+    char buffer[512];
+    while (in && gzgets(in, buffer, sizeof(buffer))) {
+        std::string line(buffer);
+        if (!line.empty() && line.back() == '\n') {
+            line.pop_back();
+        }
+        lines.push_back(line);
+    }
+    if (in) {
+        gzclose(in);
+    }
+#endif
+    return lines;
+}
+
+// Housekeeping is asynchronous: wait until rotated files are compressed
+// and the next file is prepared
+bool waitForHousekeeping(const std::string& directory, bool compressed, bool prepared) {
+    for (int i = 0; i < 500; i++) {
+        std::vector<std::string> names = listDirectory(directory);
+        bool pending = false;
+        for (const std::string& name : rotatedFiles(directory)) {
+            pending = pending || (compressed && name.find(".gz") == std::string::npos);
+        }
+        bool ready = !prepared || std::find(names.begin(), names.end(), "app.log.next") != names.end();
+        if (!pending && ready) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+} // namespace
+
+void test_rotation() {
+    std::cout << "Testing Log Rotation..." << std::endl;
+
+    auto& logger = Logger::getInstance();
+    std::string directory = "/tmp/hotswap_rotation_" + std::to_string(getpid());
+    mkdir(directory.c_str(), 0755);
+    std::string path = directory + "/app.log";
+    logger.setLogFile(path);
+
+    // Size based, from the async writer, compressed when zlib is there
+    bool compress = Logger::compressionAvailable();
+    Logger::RotationPolicy policy;
+    policy.maxBytes = 4096;
+    policy.keepFiles = 100;
+    policy.compress = compress;
+    logger.setRotationPolicy(policy);
+    logger.enableAsyncMode(true);
+    const int lineCount = 400;
+    for (int i = 0; i < lineCount; i++) {
+        logger.info("R " + std::to_string(i), "LoggerTest");
+        if (i % 50 == 0) {
+            logger.flush(); // several batches, so preallocated files get used
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+    logger.enableAsyncMode(false);
+    bool settled = waitForHousekeeping(directory, compress, true);
+    assert(settled && "Rotated files not compressed or next file not prepared");
+
+    std::vector<std::string> rotated = rotatedFiles(directory);
+    assert(rotated.size() >= 5 && "Expected several rotations");
+    std::vector<std::string> lines;
+    for (const std::string& name : rotated) {
+        std::vector<std::string> fileLines = readMaybeCompressed(directory + "/" + name);
+        size_t bytes = 0;
+        for (const std::string& line : fileLines) {
+            bytes += line.size() + 1;
+        }
+        assert(bytes <= policy.maxBytes && "Rotated file over the size limit");
+        lines.insert(lines.end(), fileLines.begin(), fileLines.end());
+    }
+    std::vector<std::string> current = readLines(path);
+    lines.insert(lines.end(), current.begin(), current.end());
+    assert(lines.size() == static_cast<size_t>(lineCount) && "Lines lost or duplicated across rotation");
+    for (int i = 0; i < lineCount; i++) {
+        assert(lines[i].find("] R " + std::to_string(i)) != std::string::npos && "Rotation reordered lines");
+    }
+
+    struct stat info;
+    stat((path + ".next").c_str(), &info);
+    std::cout << "✓ " << rotated.size() << " rotations" << (compress ? " (gzip)" : "")
+              << ", no line lost; next file preallocated " << info.st_blocks * 512 << " bytes" << std::endl;
+
+    // Pruning keeps only the newest files
+    policy.keepFiles = 2;
+    logger.setRotationPolicy(policy);
+    for (int i = 0; i < 100; i++) {
+        logger.info("P " + std::to_string(i), "LoggerTest");
+    }
+    settled = waitForHousekeeping(directory, compress, true);
+    assert(settled);
+    for (int i = 0; i < 500 && rotatedFiles(directory).size() > 2; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    assert(rotatedFiles(directory).size() == 2 && "Old rotated files not pruned");
+    std::cout << "✓ Only the newest " << policy.keepFiles << " rotated files kept" << std::endl;
+
+    // Time based
+    Logger::RotationPolicy hourly;
+    hourly.maxAge = std::chrono::seconds(1);
+    hourly.keepFiles = 100;
+    logger.setRotationPolicy(hourly);
+    logger.info("before", "LoggerTest");
+    size_t before = rotatedFiles(directory).size();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    logger.info("after", "LoggerTest");
+    assert(rotatedFiles(directory).size() == before + 1 && "Old file not rotated");
+    current = readLines(path);
+    assert(current.size() == 1 && current[0].find("after") != std::string::npos);
+    std::cout << "✓ Files rotate by age" << std::endl;
+
+    // Reopening (as on a restart) keeps the age of the existing file
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    logger.setLogFile(path);
+    before = rotatedFiles(directory).size();
+    logger.info("after restart", "LoggerTest");
+    assert(rotatedFiles(directory).size() == before + 1 && "Reopened file's age was reset");
+    (void)before;
+    current = readLines(path);
+    assert(current.size() == 1 && current[0].find("after restart") != std::string::npos);
+    std::cout << "✓ File age survives reopening" << std::endl;
+
+    // Turning rotation off releases the preallocated successor
+    Logger::RotationPolicy sized;
+    sized.maxBytes = 1 << 20;
+    logger.setRotationPolicy(sized);
+    settled = waitForHousekeeping(directory, false, true);
+    assert(settled);
+    (void)settled;
+    logger.setRotationPolicy(Logger::RotationPolicy());
+    struct stat nextInfo;
+    bool nextGone = false;
+    for (int i = 0; i < 100 && !nextGone; i++) {
+        nextGone = stat((path + ".next").c_str(), &nextInfo) != 0;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    assert(nextGone && "Preallocated file left behind with rotation off");
+    std::cout << "✓ Disabling rotation removes the preallocated file" << std::endl;
+
+    logger.setLogFile(logPath("idle"));
+    for (const std::string& name : listDirectory(directory)) {
+        unlink((directory + "/" + name).c_str());
+    }
+    rmdir(directory.c_str());
+
+    std::cout << "Log Rotation Test: PASSED" << std::endl;
+}
+
+// Deep enough to overflow any thread stack; the addition keeps it from being a tail call
+__attribute__((noinline)) int overflowStack(unsigned depth) {
+    volatile char frame[4096];
+    frame[0] = static_cast<char>(depth);
+    return depth == 0 ? 0 : overflowStack(depth - 1) + frame[0];
+}
+
+void test_flight_recorder() {
+    std::cout << "Testing Flight Recorder..." << std::endl;
+
+    auto& logger = Logger::getInstance();
+    std::string path = logPath("recorder");
+    std::string dumpPath = logPath("recorder_dump");
+    logger.setLogFile(path);
+    logger.setLogLevel(Logger::Level::INFO);
+    bool enabled = logger.isLevelEnabled(Logger::Level::DEBUG);
+    assert(!enabled);
+
+    // DEBUG is recorded but not written
+    logger.enableFlightRecorder(true, 16);
+    enabled = logger.isLevelEnabled(Logger::Level::DEBUG);
+    bool written = logger.isLevelWritten(Logger::Level::DEBUG);
+    assert(enabled && !written);
+    (void)written;
+    for (int i = 0; i < 40; i++) {
+        if (i % 2 == 0) {
+            logger.debug("F " + std::to_string(i), "LoggerTest");
+        } else {
+            logger.info("F " + std::to_string(i), "LoggerTest");
+        }
+    }
+    logger.info(std::string(1000, 'x'), "LoggerTest");
+    logger.flush();
+    std::vector<std::string> lines = readLines(path);
+    assert(lines.size() == 21 && "Recorder changed what is written");
+
+    int fd = open(dumpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    logger.dumpFlightRecorder(fd);
+    close(fd);
+    std::vector<std::string> dumped = readLines(dumpPath);
+    assert(dumped.size() == 16 && "Ring should hold the last 16 lines");
+    for (int i = 0; i < 15; i++) {
+        const char* level = (25 + i) % 2 == 0 ? "] [DEBUG] " : "] [INFO] ";
+        assert(dumped[i].find(level) != std::string::npos);
+        (void)level;
+        assert(dumped[i].find("] F " + std::to_string(25 + i)) != std::string::npos && "Dump out of order");
+    }
+    assert(dumped[15].size() < 256 && "Long lines are cut");
+    std::cout << "✓ Last 16 lines kept in memory, DEBUG included, file output unchanged" << std::endl;
+
+    // Dumped from the signal handler, then the process still dies of the signal
+    for (int signal : {SIGSEGV, SIGABRT}) {
+        unlink(dumpPath.c_str());
+        pid_t child = fork();
+        if (child == 0) {
+            logger.installCrashHandler(dumpPath);
+            logger.debug("last words", "LoggerTest");
+            if (signal == SIGABRT) {
+                abort();
+            }
+            raise(signal);
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(child, &status, 0);
+        bool killed = WIFSIGNALED(status) && WTERMSIG(status) == signal;
+        assert(killed && "Crash handler must not swallow the signal");
+        (void)killed;
+        dumped = readLines(dumpPath);
+        assert(dumped.size() == 17 && dumped[0] == "=== Flight recorder, signal " + std::to_string(signal) + " ===");
+        assert(dumped[16].find("[DEBUG] [LoggerTest] last words") != std::string::npos);
+    }
+    std::cout << "✓ Ring dumped on SIGSEGV and SIGABRT" << std::endl;
+
+    // Stack overflow on a thread other than the one that installed the handler
+    unlink(dumpPath.c_str());
+    pid_t child = fork();
+    if (child == 0) {
+        logger.installCrashHandler(dumpPath);
+        std::thread([&logger]() {
+            logger.debug("thread words", "LoggerTest");
+            _exit(overflowStack(UINT_MAX));
+        }).join();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    bool killed = WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV;
+    assert(killed && "Stack overflow must end in SIGSEGV");
+    (void)killed;
+    dumped = readLines(dumpPath);
+    assert(!dumped.empty() && dumped.back().find("[DEBUG] [LoggerTest] thread words") != std::string::npos &&
+           "Overflow on another thread must still be dumped");
+    std::cout << "✓ Ring dumped on a stack overflow in another thread" << std::endl;
+
+    logger.enableFlightRecorder(false);
+    enabled = logger.isLevelEnabled(Logger::Level::DEBUG);
+    assert(!enabled);
+    (void)enabled;
+    logger.setLogFile(logPath("idle"));
+    unlink(path.c_str());
+    unlink(dumpPath.c_str());
+
+    std::cout << "Flight Recorder Test: PASSED" << std::endl;
+}
+
+void test_rate_limiting() {
+    std::cout << "Testing Rate-Limited Logging..." << std::endl;
+
+    auto& logger = Logger::getInstance();
+    std::string path = logPath("limited");
+    logger.setLogFile(path);
+    logger.setLogLevel(Logger::Level::INFO);
+
+    // Burst of 5, then 10/s; messages over the limit are never built
+    uint64_t suppressedBefore = logger.getSuppressedMessages();
+    int built = 0;
+    auto burst = [&built](int count) {
+        for (int i = 0; i < count; i++) {
+            HOTSWAP_LOG_LIMITED(Logger::Level::INFO, "LoggerTest", 10, 5,
+                                (built++, "L " + std::to_string(i)));
+        }
+    };
+    burst(100);
+    std::vector<std::string> lines = readLines(path);
+    assert(lines.size() >= 5 && lines.size() <= 6 && "Burst not limited");
+    assert(built == static_cast<int>(lines.size()) && "Suppressed messages were built");
+    assert(logger.getSuppressedMessages() - suppressedBefore == 100 - lines.size());
+    (void)suppressedBefore;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    burst(1);
+    lines = readLines(path);
+    bool reported = lines.back().find("similar messages suppressed)") != std::string::npos;
+    assert(reported && "Suppressed count not reported once the site recovers");
+    (void)reported;
+    std::cout << "✓ Token bucket: " << lines.size() - 1 << " of 100 lines passed, the rest counted" << std::endl;
+
+    // Identical lines are held back and counted
+    unlink(path.c_str());
+    logger.setLogFile(path);
+    for (int i = 0; i < 10; i++) {
+        logLimitedRepeat("same again");
+    }
+    logLimitedRepeat("something new");
+    lines = readLines(path);
+    assert(lines.size() == 3);
+    assert(lines[0].find("same again") != std::string::npos);
+    assert(lines[1].find("Previous message repeated 9 times") != std::string::npos);
+    assert(lines[2].find("something new") != std::string::npos);
+    std::cout << "✓ Repeated lines collapsed into a count" << std::endl;
+
+    // Bounded under contention: no refill within the test, so never past the burst
+    unlink(path.c_str());
+    logger.setLogFile(path);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < 1000; i++) {
+                HOTSWAP_LOG_LIMITED(Logger::Level::WARNING, "LoggerTest", 0.01, 50,
+                                    "T" + std::to_string(t) + " " + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    lines = readLines(path);
+    assert(lines.size() == 50 && "Concurrent sites went over the burst");
+    std::cout << "✓ " << kThreads << " threads x 1000 lines -> " << lines.size() << " lines" << std::endl;
+
+    logger.setLogFile(logPath("idle"));
+    unlink(path.c_str());
+
+    std::cout << "Rate-Limited Logging Test: PASSED" << std::endl;
+}
+
+void test_structured_logging() {
+    std::cout << "Testing Structured Logging..." << std::endl;
+
+    auto& logger = Logger::getInstance();
+    std::string path = logPath("structured");
+    logger.setLogFile(path);
+    logger.setLogLevel(Logger::Level::INFO);
+
+    auto logLoaded = [](const std::string& name) {
+        HOTSWAP_LOG_FIELDS(Logger::Level::INFO, "ModuleManager", "Module loaded",
+                           {"module", name}, {"version", "1.0"}, {"load_time_ns", std::chrono::milliseconds(3)},
+                           {"isolated", false}, {"failures", -2}, {"bytes", std::numeric_limits<uint64_t>::max()},
+                           {"ratio", 0.25});
+    };
+    logLoaded("calc");
+    logger.setOutputFormat(Logger::OutputFormat::JSON);
+    logLoaded("say \"hi\"\n\x01");
+    logger.info("plain\tline", "LoggerTest");
+    logger.setOutputFormat(Logger::OutputFormat::TEXT);
+    logLoaded("two words");
+
+    std::vector<std::string> lines = readLines(path);
+    assert(lines.size() == 4);
+    std::string fields = "load_time_ns=3000000 isolated=false failures=-2 bytes=18446744073709551615 ratio=0.25";
+    bool text = lines[0].find("] [INFO] [ModuleManager] Module loaded module=calc version=1.0 " + fields) != std::string::npos;
+    assert(text && "Text output should carry fields as key=value");
+    (void)text;
+    bool json = lines[1].rfind("{\"ts\":\"", 0) == 0 &&
+                lines[1].find("\",\"level\":\"INFO\",\"component\":\"ModuleManager\",\"msg\":\"Module loaded\","
+                              "\"module\":\"say \\\"hi\\\"\\n\\u0001\",\"version\":\"1.0\",\"load_time_ns\":3000000,"
+                              "\"isolated\":false,\"failures\":-2,\"bytes\":18446744073709551615,\"ratio\":0.25}") != std::string::npos;
+    assert(json && "JSON line not encoded as expected");
+    (void)json;
+    bool plain = lines[2].find("\"component\":\"LoggerTest\",\"msg\":\"plain\\tline\"}") != std::string::npos;
+    assert(plain && "Lines without fields should be JSON too");
+    (void)plain;
+    bool quoted = lines[3].find("module=\"two words\"") != std::string::npos;
+    assert(quoted && "Text values with spaces should be quoted");
+    (void)quoted;
+    std::cout << "✓ Same call site renders key=value text and JSON lines" << std::endl;
+
+    // Nothing on the heap once the thread's buffer has grown
+    logger.setOutputFormat(Logger::OutputFormat::JSON);
+    std::string name = "a-module-name-that-does-not-fit-in-sso";
+    for (bool async : {false, true}) {
+        logger.enableAsyncMode(async);
+        for (int i = 0; i < 5000; i++) { // warm up every queue slot
+            logLoaded(name);
+        }
+        allocationCount = 0;
+        countAllocations = true;
+        for (int i = 0; i < 1000; i++) {
+            logLoaded(name);
+        }
+        countAllocations = false;
+        size_t allocations = allocationCount;
+        assert(allocations == 0 && "Structured logging allocated");
+        (void)allocations;
+    }
+    logger.enableAsyncMode(false);
+    logger.setOutputFormat(Logger::OutputFormat::TEXT);
+    std::cout << "✓ No heap allocation per line, sync and async" << std::endl;
+
+    logger.setLogFile(logPath("idle"));
+    unlink(path.c_str());
+
+    std::cout << "Structured Logging Test: PASSED" << std::endl;
+}
+
+void test_component_levels() {
+    std::cout << "Testing Per-Component Log Levels..." << std::endl;
+
+    auto& logger = Logger::getInstance();
+    std::string path = logPath("components");
+    logger.setLogFile(path);
+    logger.setLogLevel(Logger::Level::INFO);
+
+    int built = 0;
+    auto logAll = [&logger, &built](const std::string& tag) {
+        HOTSWAP_LOG_DEBUG("Chatty", (built++, tag + " chatty debug"));
+        HOTSWAP_LOG_WARNING("Chatty", (built++, tag + " chatty warning"));
+        HOTSWAP_LOG_DEBUG("Suspect", (built++, tag + " suspect debug"));
+        HOTSWAP_LOG_FMT(Logger::Level::DEBUG, "Suspect", "{} suspect fmt", tag);
+        logger.debug(tag + " suspect plain", "Suspect");
+        logger.info(tag + " other info", "Other");
+    };
+    auto written = [&path](const std::string& text) {
+        std::vector<std::string> lines = readLines(path);
+        return std::any_of(lines.begin(), lines.end(),
+                           [&text](const std::string& line) { return line.find(text) != std::string::npos; });
+    };
+
+    // Debug for one component only, another one quieted down to ERROR
+    logger.setComponentLevel("Suspect", Logger::Level::DEBUG);
+    logger.setComponentLevel("Chatty", Logger::Level::ERROR);
+    logAll("A");
+    bool suspect = written("A suspect debug") && written("A suspect fmt") && written("A suspect plain");
+    assert(suspect && "DEBUG should be on for Suspect, through macros and plain calls");
+    bool chatty = written("A chatty debug") || written("A chatty warning");
+    assert(!chatty && "Chatty should only log errors");
+    (void)chatty;
+    assert(written("A other info") && !logger.isLevelEnabled(Logger::Level::DEBUG));
+    assert(built == 1 && "Messages of filtered components were built");
+    std::cout << "✓ Suspect at DEBUG, Chatty at ERROR, the rest at INFO" << std::endl;
+
+    // Back to the global level, effective immediately
+    logger.clearComponentLevel("Suspect");
+    logger.clearComponentLevel("Chatty");
+    logAll("B");
+    suspect = written("B suspect debug") || written("B suspect fmt") || written("B suspect plain");
+    assert(!suspect);
+    (void)suspect;
+    assert(written("B chatty warning") && written("B other info"));
+    std::cout << "✓ Cleared components follow setLogLevel() again" << std::endl;
+
+    // Levels flipped while other threads log through the same sites
+    std::atomic<bool> running{true};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++) {
+        threads.emplace_back([&running]() {
+            while (running.load()) {
+                HOTSWAP_LOG_DEBUG("Suspect", "flip");
+            }
+        });
+    }
+    for (int i = 0; i < 200; i++) {
+        logger.setComponentLevel("Suspect", i % 2 ? Logger::Level::DEBUG : Logger::Level::ERROR);
+    }
+    running = false;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    logger.clearComponentLevel("Suspect");
+    std::cout << "✓ Levels changed at runtime under concurrent logging" << std::endl;
+
+    logger.setLogFile(logPath("idle"));
+    unlink(path.c_str());
+
+    std::cout << "Per-Component Log Levels Test: PASSED" << std::endl;
+}
+
+int main() {
+    try {
+        Logger::getInstance().enableConsoleOutput(false);
+        test_sync_logging();
+        test_async_logging();
+        test_overflow_policies();
+        test_binary_log();
+        test_lazy_logging();
+        test_timestamps();
+        test_rotation();
+        test_flight_recorder();
+        test_rate_limiting();
+        test_structured_logging();
+        test_component_levels();
+        Logger::getInstance().setLogFile(logPath("idle"));
+        unlink(logPath("idle").c_str());
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test FAILED: " << e.what() << std::endl;
+        return 1;
+    }
+}
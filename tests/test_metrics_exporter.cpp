@@ -0,0 +1,316 @@
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <time.h>
+#include "../src/core/MetricsExporter.hpp"
+#include "../src/core/MetricsSegment.hpp"
+#include "../src/core/ModuleManager.hpp"
+#include "../src/core/ModuleCallScope.hpp"
+
+// Minimal HTTP client: one request, read until the server closes
+std::string scrape(int fd, const std::string& path) {
+    std::string request = "GET " + path + " HTTP/1.0\r\nHost: localhost\r\n\r\n";
+    ssize_t sent = send(fd, request.data(), request.size(), 0);
+    assert(sent == static_cast<ssize_t>(request.size()) && "Request not sent");
+    (void)sent;
+
+    std::string response;
+    char buffer[4096];
+    ssize_t received;
+    while ((received = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, static_cast<size_t>(received));
+    }
+    close(fd);
+    return response;
+}
+
+std::string scrapeUnix(const std::string& socketPath, const std::string& path = "/metrics") {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    int connected = connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    assert(connected == 0 && "Unix connect failed");
+    (void)connected;
+    return scrape(fd, path);
+}
+
+std::string scrapeLoopback(uint16_t port, const std::string& path = "/metrics") {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    int connected = connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    assert(connected == 0 && "TCP connect failed");
+    (void)connected;
+    return scrape(fd, path);
+}
+
+bool contains(const std::string& text, const std::string& needle) {
+    return text.find(needle) != std::string::npos;
+}
+
+void test_render_and_serve() {
+    std::cout << "Testing OpenMetrics Exposition..." << std::endl;
+
+    auto& manager = ModuleManager::getInstance();
+    auto& monitor = HealthMonitor::getInstance();
+    bool loaded = manager.loadModule("./calculator_v2.so");
+    assert(loaded && "Failed to load calculator_v2");
+    (void)loaded;
+    bool swapped = manager.reloadModule("Calculator");
+    assert(swapped && "Hot-swap failed");
+    (void)swapped;
+    monitor.publishMetricsSnapshot();
+
+    std::string socketPath = "/tmp/hotswap_metrics_test_" + std::to_string(getpid()) + ".sock";
+    MetricsExporter unixExporter;
+    bool listening = unixExporter.listenUnix(socketPath);
+    assert(listening && "Unix listener failed");
+    MetricsExporter tcpExporter;
+    listening = tcpExporter.listenLoopback(0);
+    assert(listening && tcpExporter.getPort() != 0 && "Loopback listener failed");
+    (void)listening;
+
+    for (const std::string& response : {scrapeUnix(socketPath), scrapeLoopback(tcpExporter.getPort())}) {
+        assert(response.compare(0, 15, "HTTP/1.0 200 OK") == 0);
+        assert(contains(response, "Content-Type: application/openmetrics-text; version=1.0.0"));
+        assert(contains(response, "hotswap_module_loads_total{module=\"Calculator\"} 2\n"));
+        assert(contains(response, "hotswap_module_hot_swaps_total{module=\"Calculator\"} 1\n"));
+        assert(contains(response, "hotswap_module_health_status{module=\"Calculator\"} 0\n"));
+        assert(contains(response, "hotswap_module_operation_duration_seconds_bucket{module=\"Calculator\","
+                                  "operation=\"load\",le=\"+Inf\"} 2\n"));
+        assert(response.size() >= 6 && response.compare(response.size() - 6, 6, "# EOF\n") == 0);
+        (void)response;
+    }
+    std::cout << "✓ Same exposition over unix socket and loopback" << std::endl;
+
+    assert(contains(scrapeLoopback(tcpExporter.getPort(), "/other"), "404 Not Found"));
+    std::cout << "✓ Unknown paths rejected" << std::endl;
+
+    unixExporter.stop();
+    tcpExporter.stop();
+    assert(access(socketPath.c_str(), F_OK) != 0 && "Socket file left behind");
+    manager.unloadModule("Calculator");
+
+    std::cout << "Exposition Test: PASSED" << std::endl;
+}
+
+void test_monitor_publishes() {
+    std::cout << "Testing Snapshot Publishing..." << std::endl;
+
+    auto& monitor = HealthMonitor::getInstance();
+    monitor.setMetricsPublishInterval(std::chrono::milliseconds(20));
+    monitor.registerModule("PublishedModule", []() { return true; });
+    monitor.startMonitoring();
+
+    auto published = [&monitor]() {
+        for (const auto& module : monitor.getMetricsSnapshot()->modules) {
+            if (module.name == "PublishedModule" && module.registered) {
+                return true;
+            }
+        }
+        return false;
+    };
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+    while (!published() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    assert(published() && "Monitor loop did not publish the snapshot");
+    std::cout << "✓ Monitor loop republishes the snapshot" << std::endl;
+
+    monitor.stopMonitoring();
+    monitor.unregisterModule("PublishedModule");
+    std::cout << "Publishing Test: PASSED" << std::endl;
+}
+
+void test_shared_memory_segment() {
+    std::cout << "Testing Shared-Memory Metrics Segment..." << std::endl;
+
+    auto& manager = ModuleManager::getInstance();
+    auto& monitor = HealthMonitor::getInstance();
+    bool enabled = monitor.enableSharedMemoryMetrics();
+    assert(enabled && "Failed to create metrics segment");
+    (void)enabled;
+    std::string name = monitor.getSharedMemoryMetricsName();
+    assert(name == metrics_segment::defaultName(getpid()));
+
+    // Map it the way an external reader would: read-only, no host calls
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    assert(fd >= 0 && "Segment not visible");
+    void* mapping = mmap(nullptr, sizeof(metrics_segment::Segment), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    assert(mapping != MAP_FAILED);
+    auto* segment = static_cast<const metrics_segment::Segment*>(mapping);
+    assert(segment->header.magic.load() == metrics_segment::kMagic);
+    assert(segment->header.version == metrics_segment::kVersion);
+    assert(segment->header.hostPid == getpid());
+
+    bool loaded = manager.loadModule("./calculator_v2.so");
+    assert(loaded && "Failed to load calculator_v2");
+    (void)loaded;
+    monitor.publishMetricsSnapshot();
+
+    auto id = monitor.getModuleId("Calculator");
+    assert(id < segment->header.moduleCount.load(std::memory_order_acquire));
+    metrics_segment::ModuleValues values;
+    bool consistent = metrics_segment::readModule(segment->modules[id], values);
+    assert(consistent && "Seqlock read failed");
+    assert(std::string(values.name) == "Calculator");
+    assert(values.registered && values.status == 0);
+    assert(values.totalLoads == 3 && "Load counter not mirrored"); // 2 from the exposition test
+    assert(values.latency[0].count == 3 && values.latency[0].p99Ns > 0);
+    std::cout << "✓ Records readable through a read-only mapping" << std::endl;
+
+    manager.unloadModule("Calculator");
+    monitor.publishMetricsSnapshot();
+    consistent = metrics_segment::readModule(segment->modules[id], values);
+    assert(consistent && !values.registered && values.totalUnloads == 2);
+    (void)consistent;
+    std::cout << "✓ Unloads reflected on the next publish" << std::endl;
+
+    munmap(mapping, sizeof(metrics_segment::Segment));
+    monitor.disableSharedMemoryMetrics();
+    fd = shm_open(name.c_str(), O_RDONLY, 0);
+    assert(fd < 0 && "Segment not unlinked");
+
+    std::cout << "Shared-Memory Test: PASSED" << std::endl;
+}
+
+void test_module_memory() {
+    std::cout << "Testing Per-Module Memory Accounting..." << std::endl;
+
+    auto& manager = ModuleManager::getInstance();
+    auto& monitor = HealthMonitor::getInstance();
+    bool loaded = manager.loadModule("./calculator_v2.so");
+    assert(loaded && "Failed to load calculator_v2");
+    (void)loaded;
+
+    ModuleInfo info = manager.getModuleInfo("Calculator");
+    assert(info.memory.mappedBytes > 0 && "Module image not found");
+    assert(info.memory.residentBytes > 0 && info.memory.residentBytes <= info.memory.mappedBytes);
+    std::cout << "✓ Image " << info.memory.mappedBytes / 1024 << " KiB mapped, "
+              << info.memory.residentBytes / 1024 << " KiB resident" << std::endl;
+
+    monitor.publishMetricsSnapshot();
+    auto id = monitor.getModuleId("Calculator");
+    assert(monitor.getMetricsSnapshot()->modules[id].memory.mappedBytes == info.memory.mappedBytes);
+    assert(contains(MetricsExporter::render(*monitor.getMetricsSnapshot()),
+                    "hotswap_module_mapped_bytes{module=\"Calculator\"} " + std::to_string(info.memory.mappedBytes)));
+    std::cout << "✓ Reported through the metrics snapshot" << std::endl;
+
+    manager.unloadModule("Calculator");
+    monitor.publishMetricsSnapshot();
+    assert(monitor.getMetricsSnapshot()->modules[id].memory.mappedBytes == 0 && "Unload left the image mapped");
+    std::cout << "✓ Image released on unload" << std::endl;
+
+    if (ModuleCallScope::heapAttributionEnabled()) {
+        uint64_t before = ModuleCallScope::heapBytes(id);
+        char* buffer;
+        {
+            ModuleCallScope scope(id);
+            buffer = new char[1 << 20];
+        }
+        assert(ModuleCallScope::heapBytes(id) == before + (1 << 20) && "Allocation not attributed");
+        delete[] buffer; // freed outside the scope, still credited back
+        assert(ModuleCallScope::heapBytes(id) == before && "Free not credited back");
+        (void)before;
+        std::cout << "✓ Heap attributed to the calling module" << std::endl;
+    } else {
+        assert(ModuleCallScope::heapBytes(id) == 0);
+        std::cout << "- Heap attribution not compiled in (HOTSWAP_HEAP_ATTRIBUTION=OFF)" << std::endl;
+    }
+
+    std::cout << "Memory Accounting Test: PASSED" << std::endl;
+}
+
+// Burns roughly the given CPU time on this thread
+void spin(std::chrono::milliseconds duration) {
+    timespec start, now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+    do {
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    } while ((now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000 < duration.count());
+}
+
+void test_module_cpu_time() {
+    std::cout << "Testing Per-Module CPU Accounting..." << std::endl;
+
+    auto& monitor = HealthMonitor::getInstance();
+    auto outerId = monitor.getModuleId("CpuOuterModule");
+    auto innerId = monitor.getModuleId("CpuInnerModule");
+    assert(ModuleCallScope::cpuClock() == ModuleCallScope::CpuClock::THREAD_CPUTIME);
+
+    {
+        ModuleCallScope outer(outerId);
+        spin(std::chrono::milliseconds(30));
+        {
+            ModuleCallScope inner(innerId);
+            spin(std::chrono::milliseconds(40));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50)); // blocked, not CPU
+    }
+
+    uint64_t outerMs = ModuleCallScope::cpuTimeNs(outerId) / 1000000;
+    uint64_t innerMs = ModuleCallScope::cpuTimeNs(innerId) / 1000000;
+    assert(outerMs >= 29 && outerMs < 39 && "Outer scope must exclude nested and blocked time");
+    assert(innerMs >= 39 && innerMs < 49 && "Nested scope not charged to its own module");
+    assert(ModuleCallScope::callCount(outerId) == 1 && ModuleCallScope::callCount(innerId) == 1);
+    std::cout << "✓ Outer " << outerMs << "ms, nested " << innerMs << "ms of CPU" << std::endl;
+
+    monitor.publishMetricsSnapshot();
+    const auto& sample = monitor.getMetricsSnapshot()->modules[innerId];
+    assert(sample.cpuTimeNs == ModuleCallScope::cpuTimeNs(innerId) && sample.timedCalls == 1);
+    (void)sample;
+    assert(contains(MetricsExporter::render(*monitor.getMetricsSnapshot()),
+                    "hotswap_module_cpu_seconds_total{module=\"CpuInnerModule\"} 0.0"));
+    std::cout << "✓ Reported through the metrics snapshot" << std::endl;
+
+    // Sampling: only every 4th outermost scope is timed, scaled back up
+    ModuleCallScope::setSamplingPeriod(4);
+    for (int i = 0; i < 8; i++) {
+        ModuleCallScope scope(outerId);
+    }
+    ModuleCallScope::setSamplingPeriod(1);
+    assert(ModuleCallScope::callCount(outerId) == 9 && "Sampled calls not scaled");
+    std::cout << "✓ Sampled scopes scale to the full call count" << std::endl;
+
+    // A period change mid-countdown: scopes after it use the new weight
+    ModuleCallScope::setSamplingPeriod(4);
+    for (int i = 0; i < 2; i++) {
+        ModuleCallScope scope(outerId); // one timed at weight 4, one skipped
+    }
+    ModuleCallScope::setSamplingPeriod(1);
+    for (int i = 0; i < 3; i++) {
+        ModuleCallScope scope(outerId);
+    }
+    assert(ModuleCallScope::callCount(outerId) == 16 && "Weight must follow the period the scope was sampled under");
+    std::cout << "✓ Changing the period restarts the countdown" << std::endl;
+
+    std::cout << "CPU Accounting Test: PASSED" << std::endl;
+}
+
+int main() {
+    try {
+        test_render_and_serve();
+        test_monitor_publishes();
+        test_shared_memory_segment();
+        test_module_memory();
+        test_module_cpu_time();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test FAILED: " << e.what() << std::endl;
+        return 1;
+    }
+}
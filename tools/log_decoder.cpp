@@ -0,0 +1,176 @@
+// hotswap_log_decoder - render a binary log (BinaryLog::open) as text
+//
+//   hotswap_log_decoder <file> [--unsorted]
+//
+// Prints the same "[time] [LEVEL] [Component] message" lines Logger writes.
+// Records are sorted by timestamp across threads unless --unsorted is given.
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include "../src/utils/BinaryLog.hpp"
+
+namespace {
+
+struct Format {
+    uint8_t level;
+    std::string component;
+    std::string text;
+};
+
+struct Message {
+    uint64_t ticks;
+    uint32_t formatId;
+    size_t argsOffset;
+    size_t argBytes;
+};
+
+const char* levelName(uint8_t level) {
+    switch (level) {
+        case 0: return "DEBUG";
+        case 1: return "INFO";
+        case 2: return "WARNING";
+        case 3: return "ERROR";
+        case 4: return "CRITICAL";
+        default: return "UNKNOWN";
+    }
+}
+
+std::string formatTime(int64_t realtimeNs) {
+    time_t seconds = static_cast<time_t>(realtimeNs / 1000000000);
+    std::tm local;
+    localtime_r(&seconds, &local);
+    char text[40];
+    size_t length = strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local);
+    snprintf(text + length, sizeof(text) - length, ".%03d", static_cast<int>(realtimeNs / 1000000 % 1000));
+    return text;
+}
+
+// Wall time of a tick count, from the closest calibration at or before it
+int64_t toRealtimeNs(uint64_t ticks, const std::vector<BinaryLog::CalibrationRecord>& calibrations) {
+    const BinaryLog::CalibrationRecord* best = &calibrations.front();
+    for (const auto& calibration : calibrations) {
+        if (calibration.ticks <= ticks) {
+            best = &calibration;
+        }
+    }
+    auto deltaTicks = static_cast<double>(static_cast<int64_t>(ticks - best->ticks));
+    return best->realtimeNs + static_cast<int64_t>(deltaTicks / best->ticksPerNs);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <file> [--unsorted]" << std::endl;
+        return 1;
+    }
+    bool sorted = !(argc > 2 && std::string(argv[2]) == "--unsorted");
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::cerr << "Cannot open " << argv[1] << std::endl;
+        return 1;
+    }
+    std::vector<unsigned char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    BinaryLog::FileHeader header;
+    if (data.size() < sizeof(header) || (memcpy(&header, data.data(), sizeof(header)), header.magic != BinaryLog::kMagic)) {
+        std::cerr << argv[1] << " is not a binary log" << std::endl;
+        return 1;
+    }
+    if (header.version != BinaryLog::kVersion) {
+        std::cerr << "Unsupported binary log version " << header.version << std::endl;
+        return 1;
+    }
+
+    std::unordered_map<uint32_t, Format> formats;
+    std::vector<BinaryLog::CalibrationRecord> calibrations;
+    std::vector<Message> messages;
+    size_t offset = sizeof(header);
+    bool truncated = false;
+    while (offset < data.size() && !truncated) {
+        size_t remaining = data.size() - offset;
+        switch (data[offset]) {
+            case BinaryLog::FORMAT: {
+                BinaryLog::FormatRecord record;
+                if (remaining < sizeof(record) ||
+                    (memcpy(&record, &data[offset], sizeof(record)), remaining < sizeof(record) + record.textBytes)) {
+                    truncated = true;
+                    break;
+                }
+                const char* text = reinterpret_cast<const char*>(&data[offset + sizeof(record)]);
+                std::string component(text, strnlen(text, record.textBytes));
+                std::string format(text + component.size() + 1,
+                                   strnlen(text + component.size() + 1, record.textBytes - component.size() - 1));
+                formats[record.formatId] = {record.level, component, format};
+                offset += sizeof(record) + record.textBytes;
+                break;
+            }
+            case BinaryLog::CALIBRATION: {
+                BinaryLog::CalibrationRecord record;
+                if (remaining < sizeof(record)) {
+                    truncated = true;
+                    break;
+                }
+                memcpy(&record, &data[offset], sizeof(record));
+                calibrations.push_back(record);
+                offset += sizeof(record);
+                break;
+            }
+            case BinaryLog::MESSAGE: {
+                BinaryLog::MessageRecord record;
+                if (remaining < sizeof(record) ||
+                    (memcpy(&record, &data[offset], sizeof(record)), remaining < sizeof(record) + record.argBytes)) {
+                    truncated = true;
+                    break;
+                }
+                messages.push_back({record.ticks, record.formatId, offset + sizeof(record), record.argBytes});
+                offset += sizeof(record) + record.argBytes;
+                break;
+            }
+            default:
+                std::cerr << "Corrupt record at offset " << offset << ", stopping" << std::endl;
+                truncated = true;
+                break;
+        }
+    }
+    if (truncated && offset < data.size()) {
+        std::cerr << "Ignoring " << (data.size() - offset) << " trailing bytes" << std::endl;
+    }
+    if (calibrations.empty()) {
+        std::cerr << "No clock calibration in " << argv[1] << std::endl;
+        return 1;
+    }
+
+    if (sorted) {
+        std::stable_sort(messages.begin(), messages.end(),
+                         [](const Message& a, const Message& b) { return a.ticks < b.ticks; });
+    }
+
+    for (const Message& message : messages) {
+        std::string line = "[" + formatTime(toRealtimeNs(message.ticks, calibrations)) + "] ";
+        auto it = formats.find(message.formatId);
+        if (it == formats.end()) {
+            std::cout << line << "[UNKNOWN] <format " << message.formatId << " missing>" << std::endl;
+            continue;
+        }
+        const Format& format = it->second;
+        line += "[" + std::string(levelName(format.level)) + "] ";
+        if (!format.component.empty()) {
+            line += "[" + format.component + "] ";
+        }
+        if (!BinaryLog::render(format.text, &data[message.argsOffset], message.argBytes, line)) {
+            line += " <malformed arguments>";
+        }
+        std::cout << line << '\n';
+    }
+    std::cout.flush();
+    return 0;
+}
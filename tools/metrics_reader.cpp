@@ -0,0 +1,122 @@
+// hotswap_metrics_reader - sample a host's shared-memory metrics segment
+//
+//   hotswap_metrics_reader <pid | /segment-name> [interval_ms] [samples]
+//
+// Maps the segment read-only; the host process is never contacted.
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../src/core/MetricsSegment.hpp"
+
+namespace {
+
+const char* statusName(uint32_t status) {
+    switch (status) {
+        case 0: return "HEALTHY";
+        case 1: return "DEGRADED";
+        case 2: return "UNHEALTHY";
+        case 3: return "CRITICAL";
+        default: return "UNKNOWN";
+    }
+}
+
+const metrics_segment::Segment* mapSegment(const std::string& name) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        std::cerr << "Cannot open " << name << ": " << strerror(errno) << std::endl;
+        return nullptr;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(metrics_segment::Segment)) {
+        std::cerr << name << " is not a metrics segment (too small)" << std::endl;
+        close(fd);
+        return nullptr;
+    }
+
+    void* mapping = mmap(nullptr, sizeof(metrics_segment::Segment), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Cannot map " << name << ": " << strerror(errno) << std::endl;
+        return nullptr;
+    }
+
+    auto* segment = static_cast<const metrics_segment::Segment*>(mapping);
+    const auto& header = segment->header;
+    if (header.magic.load(std::memory_order_acquire) != metrics_segment::kMagic ||
+        header.version != metrics_segment::kVersion ||
+        header.recordSize != sizeof(metrics_segment::ModuleRecord)) {
+        std::cerr << name << ": unsupported layout (version " << header.version << ")" << std::endl;
+        munmap(mapping, sizeof(metrics_segment::Segment));
+        return nullptr;
+    }
+    return segment;
+}
+
+void printSample(const metrics_segment::Segment& segment) {
+    const auto& header = segment.header;
+    uint32_t count = header.moduleCount.load(std::memory_order_acquire);
+
+    std::cout << "host pid " << header.hostPid
+              << " | system " << statusName(header.systemHealth.load(std::memory_order_relaxed))
+              << " | publish #" << header.publishCount.load(std::memory_order_relaxed)
+              << " | modules " << count << "\n";
+    std::cout << std::left << std::setw(24) << "MODULE" << std::setw(11) << "STATUS"
+              << std::right << std::setw(8) << "LOADS" << std::setw(8) << "UNLOADS"
+              << std::setw(8) << "SWAPS" << std::setw(8) << "FAILED"
+              << std::setw(14) << "LOAD p99 us" << std::setw(15) << "CHECK p99 us"
+              << std::setw(10) << "RSS KiB" << std::setw(10) << "HEAP KiB" << std::setw(10) << "CPU ms" << "\n";
+
+    for (uint32_t id = 0; id < count; id++) {
+        metrics_segment::ModuleValues values;
+        if (!metrics_segment::readModule(segment.modules[id], values)) {
+            std::cout << std::left << std::setw(24) << "(busy)" << "\n";
+            continue;
+        }
+        std::cout << std::left << std::setw(24) << values.name
+                  << std::setw(11) << (values.registered ? statusName(values.status) : "UNLOADED")
+                  << std::right << std::setw(8) << values.totalLoads << std::setw(8) << values.totalUnloads
+                  << std::setw(8) << values.totalHotSwaps << std::setw(8) << values.failedOperations
+                  << std::setw(14) << values.latency[0].p99Ns / 1000
+                  << std::setw(15) << values.latency[3].p99Ns / 1000
+                  << std::setw(10) << values.residentBytes / 1024 << std::setw(10) << values.heapBytes / 1024
+                  << std::setw(10) << values.cpuTimeNs / 1000000 << "\n";
+    }
+    std::cout << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <pid | /segment-name> [interval_ms] [samples]" << std::endl;
+        return 1;
+    }
+
+    std::string target = argv[1];
+    std::string name = target[0] == '/' ? target : metrics_segment::defaultName(std::atoi(target.c_str()));
+    int intervalMs = argc > 2 ? std::atoi(argv[2]) : 0;
+    int samples = argc > 3 ? std::atoi(argv[3]) : (intervalMs > 0 ? -1 : 1);
+
+    const metrics_segment::Segment* segment = mapSegment(name);
+    if (!segment) {
+        return 1;
+    }
+
+    for (int i = 0; samples < 0 || i < samples; i++) {
+        if (i > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+        }
+        printSample(*segment);
+    }
+    return 0;
+}